@@ -8,6 +8,14 @@
 option(SIMPLE_TR8N_ENABLE_EXCEPTIONS "Enables C++ exceptions for SimpleTr8n" ON)
 mark_as_advanced(SIMPLE_TR8N_ENABLE_EXCEPTIONS)
 
+# SIMD (SSE2/AVX2 on x86) message template scanning:
+option(SIMPLE_TR8N_ENABLE_SIMD "Enables SIMD message template scanning for SimpleTr8n" ON)
+mark_as_advanced(SIMPLE_TR8N_ENABLE_SIMD)
+
+# Per-message metrics and latency sampling in SimpleTranslator:
+option(SIMPLE_TR8N_ENABLE_METRICS "Enables SimpleTranslator metrics for SimpleTr8n" OFF)
+mark_as_advanced(SIMPLE_TR8N_ENABLE_METRICS)
+
 # simple_tr8n::string_view type:
 set(SIMPLE_TR8N_STRING_VIEW_TYPE "std" CACHE STRING
     "SimpleTr8n: string_view implementation to use (std, lite, or custom)")
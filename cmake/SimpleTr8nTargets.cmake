@@ -61,6 +61,26 @@ function(simple_tr8n_library name)
   # TODO: Configure installation, if necessary.
 endfunction()
 
+## If tools for this project are enabled, adds command-line tool executable
+## with SimpleTr8n project defaults. Creates executable named SimpleTr8n_${name}.
+##
+## All remaining arguments are passed to add_executable().
+function(simple_tr8n_tool name)
+  if(NOT SIMPLE_TR8N_ENABLE_TOOLS)
+    # Project tools off, so simple_tr8n_tool() should never have been invoked.
+    message(FATAL_ERROR "Must guard tool targets with SIMPLE_TR8N_ENABLE_TOOLS")
+  endif()
+
+  add_executable(SimpleTr8n_${name} ${ARGN})
+
+  # Always include the src/ dir as a base include path.
+  target_include_directories(SimpleTr8n_${name}
+      PUBLIC ${SimpleTr8n_SOURCE_DIR}/src)
+
+  target_compile_features(SimpleTr8n_${name} PUBLIC cxx_std_14)
+  simple_tr8n_enable_warnings(${name})
+endfunction()
+
 ## If testing for this project is enabled, adds test executable and matching
 ## CTest test with SimpleTr8n project defaults. Creates executable named
 ## SimpleTr8n_${name}.
@@ -88,3 +108,26 @@ function(simple_tr8n_gtest name)
   gtest_discover_tests(SimpleTr8n_${name}
       WORKING_DIRECTORY ${SimpleTr8n_BINARY_DIR}/stage/${CMAKE_INSTALL_BINDIR})
 endfunction()
+
+## If benchmarks for this project are enabled, adds Google Benchmark executable
+## with SimpleTr8n project defaults. Creates executable named SimpleTr8n_${name}.
+##
+## All remaining arguments are passed to add_executable().
+function(simple_tr8n_benchmark name)
+  if(NOT SIMPLE_TR8N_ENABLE_BENCHMARKS)
+    # Project benchmarks off, so simple_tr8n_benchmark() should never have been invoked.
+    message(FATAL_ERROR "Must guard benchmark targets with SIMPLE_TR8N_ENABLE_BENCHMARKS")
+  endif()
+
+  add_executable(SimpleTr8n_${name} ${ARGN})
+
+  # Always include the src/ dir as a base include path.
+  target_include_directories(SimpleTr8n_${name}
+      PUBLIC ${SimpleTr8n_SOURCE_DIR}/src)
+
+  target_compile_features(SimpleTr8n_${name} PUBLIC cxx_std_14)
+  simple_tr8n_enable_warnings(${name})
+
+  target_link_libraries(SimpleTr8n_${name}
+      PRIVATE benchmark::benchmark benchmark::benchmark_main)
+endfunction()
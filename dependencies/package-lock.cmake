@@ -25,3 +25,14 @@ CPMDeclarePackage(googletest
   GIT_REPOSITORY https://github.com/google/googletest
   EXCLUDE_FROM_ALL
 )
+# benchmark
+CPMDeclarePackage(benchmark
+  NAME benchmark
+  VERSION 1.7.1
+  GIT_TAG v1.7.1
+  GIT_REPOSITORY https://github.com/google/benchmark
+  OPTIONS
+    "BENCHMARK_ENABLE_TESTING OFF"
+    "BENCHMARK_ENABLE_INSTALL OFF"
+  EXCLUDE_FROM_ALL
+)
@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_CACHING_TRANSLATOR_HPP
+#define SIMPLE_TR8N_CACHING_TRANSLATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/perfect_hash.hpp"
+#include "simple_tr8n/string_view.hpp"
+#include "simple_tr8n/translator.hpp"
+
+namespace simple_tr8n {
+
+/** Options for CachingTranslator. */
+struct CacheOptions {
+  /** Number of independently locked shards. */
+  std::size_t numShards = 16;
+
+  /** Maximum cached translations per shard (least recently used are evicted). */
+  std::size_t maxEntriesPerShard = 256;
+
+  /** Calls with more arguments than this bypass the cache. */
+  std::size_t maxArgs = TransArgs<char>::kInlineArgs;
+};
+
+/** Hit and miss counts for a CachingTranslator. */
+struct CacheStats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;     // Includes calls that bypassed the cache.
+  std::size_t evictions = 0;
+  std::size_t size = 0;       // Translations currently cached.
+
+  /** Fraction of calls served from the cache (0 if there were no calls). */
+  double hitRate() const {
+    const std::size_t calls = hits + misses;
+    return (calls > 0) ? static_cast<double>(hits) / static_cast<double>(calls) : 0.0;
+  }
+};
+
+/**
+ * Translator decorator that memoizes fully rendered translations, keyed by
+ * message type, plural count, and argument keys and values (in the order
+ * added). Meant for messages translated over and over with the same
+ * arguments, like status labels and day names.
+ *
+ * The cache is split into shards, each with its own lock and least recently
+ * used eviction, so threads translating different messages rarely contend.
+ * Rendering on a miss happens outside of any lock.
+ *
+ * Translations are cached forever (until evicted or clear() is called), so
+ * the wrapped translator's results must not change: call clear() after e.g.
+ * ReloadableTranslator::reload(). Failed translations are not cached: if
+ * exceptions are enabled they throw as usual, and otherwise they render as
+ * empty strings, which are never cached (so that e.g. a message type added
+ * by a later reload isn't hidden behind a cached failure).
+ */
+template<typename CharT>
+class CachingTranslator : public Translator<CharT> {
+public:
+  using string_type = typename Translator<CharT>::string_type;
+  using result_ptr = std::shared_ptr<const string_type>;
+
+  using Translator<CharT>::translate;
+  using Translator<CharT>::translatePlural;
+
+  explicit CachingTranslator(
+      std::shared_ptr<const Translator<CharT>> translator, CacheOptions options = CacheOptions{})
+      : translator_{std::move(translator)},
+        options_{options},
+        shards_{std::make_unique<Shard[]>(options.numShards)} {
+    Expects(translator_ != nullptr);
+    Expects(options_.numShards > 0);
+    Expects(options_.maxEntriesPerShard > 0);
+  }
+
+  ~CachingTranslator() override = default;
+
+  CachingTranslator(const CachingTranslator&) = delete;
+  CachingTranslator& operator=(const CachingTranslator&) = delete;
+
+  CachingTranslator(CachingTranslator&&) = delete;
+  CachingTranslator& operator=(CachingTranslator&&) = delete;
+
+  /**
+   * Same as translate(msgType), but returns a shared reference to the cached
+   * translation, avoiding any copy (and any allocation on cache hits).
+   */
+  result_ptr translateShared(basic_string_view<CharT> msgType) const {
+    return lookup(msgType, internal::kNoCount, TransArgs<CharT>{});
+  }
+
+  /** Same as translate(msgType, args), but returns a shared reference. */
+  result_ptr translateShared(basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const {
+    return lookup(msgType, internal::kNoCount, args);
+  }
+
+  /** Same as translatePlural(msgType, pluralCount, args), but returns a shared reference. */
+  result_ptr translatePluralShared(
+      basic_string_view<CharT> msgType, int pluralCount, const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    return lookup(msgType, pluralCount, args);
+  }
+
+  string_type translate(basic_string_view<CharT> msgType) const override {
+    return *translateShared(msgType);
+  }
+
+  string_type translate(
+      basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const override {
+    return *translateShared(msgType, args);
+  }
+
+  string_type translatePlural(
+      basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const override {
+    return *translatePluralShared(msgType, pluralCount, args);
+  }
+
+  void translateTo(string_type& out, basic_string_view<CharT> msgType) const override {
+    out.append(*translateShared(msgType));
+  }
+
+  void translateTo(
+      string_type& out, basic_string_view<CharT> msgType,
+      const TransArgs<CharT>& args) const override {
+    out.append(*translateShared(msgType, args));
+  }
+
+  void translatePluralTo(
+      string_type& out, basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const override {
+    out.append(*translatePluralShared(msgType, pluralCount, args));
+  }
+
+  /** Removes all cached translations (keeping stats). */
+  void clear() {
+    for (std::size_t i = 0; i < options_.numShards; ++i) {
+      Shard& shard = shards_[i];
+      const std::lock_guard<std::mutex> lock{shard.mutex};
+      shard.entries.clear();
+      shard.recency.clear();
+    }
+  }
+
+  /** Returns stats summed across all shards. */
+  CacheStats stats() const {
+    CacheStats total;
+    for (std::size_t i = 0; i < options_.numShards; ++i) {
+      const Shard& shard = shards_[i];
+      const std::lock_guard<std::mutex> lock{shard.mutex};
+      total.hits += shard.stats.hits;
+      total.misses += shard.stats.misses;
+      total.evictions += shard.stats.evictions;
+      total.size += shard.entries.size();
+    }
+    return total;
+  }
+
+private:
+  struct Entry {
+    result_ptr translation;
+    typename std::list<const std::string*>::iterator recency;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<const std::string*> recency;  // Keys of entries, most recently used first.
+    CacheStats stats;                       // Note: size is computed by stats().
+
+    // Note: Keeps neighboring shards' locks and counters off each other's cache
+    // lines. (Over-aligning Shard instead would need C++17 aligned new.)
+    char padding[64];
+  };
+
+  /** Appends the raw bytes of count values to key. */
+  template<typename T>
+  static void appendBytes(std::string& key, const T* data, std::size_t count) {
+    key.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+  }
+
+  static void appendField(std::string& key, basic_string_view<CharT> field) {
+    const std::size_t size = field.size();
+    appendBytes(key, &size, 1);
+    appendBytes(key, field.data(), size);
+  }
+
+  /** Encodes everything that determines the rendered translation into key. */
+  static void makeKey(
+      std::string& key, basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) {
+    key.clear();
+    appendBytes(key, &pluralCount, 1);
+    appendField(key, msgType);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+      appendField(key, args.at(i).first);
+      appendField(key, args.at(i).second);
+    }
+  }
+
+  Shard& shardFor(std::uint64_t hash) const {
+    return shards_[static_cast<std::size_t>(hash % options_.numShards)];
+  }
+
+  string_type render(
+      basic_string_view<CharT> msgType, int pluralCount, const TransArgs<CharT>& args) const {
+    return (pluralCount == internal::kNoCount)
+               ? translator_->translate(msgType, args)
+               : translator_->translatePlural(msgType, pluralCount, args);
+  }
+
+  result_ptr lookup(
+      basic_string_view<CharT> msgType, int pluralCount, const TransArgs<CharT>& args) const {
+    if (args.size() > options_.maxArgs) {
+      Shard& shard = shardFor(internal::hashKey<CharT>(msgType, 0));
+      {
+        const std::lock_guard<std::mutex> lock{shard.mutex};
+        ++shard.stats.misses;
+      }
+      return std::make_shared<const string_type>(render(msgType, pluralCount, args));
+    }
+
+    // Note: Reused across calls so that hits don't allocate. Only used before
+    // rendering, which may reenter another CachingTranslator on this thread.
+    thread_local std::string scratchKey;
+    makeKey(scratchKey, msgType, pluralCount, args);
+    Shard& shard = shardFor(internal::hashBytes(scratchKey.data(), scratchKey.size(), 0));
+
+    {
+      const std::lock_guard<std::mutex> lock{shard.mutex};
+      const auto itr = shard.entries.find(scratchKey);
+      if (itr != shard.entries.end()) {
+        ++shard.stats.hits;
+        shard.recency.splice(shard.recency.begin(), shard.recency, itr->second.recency);
+        return itr->second.translation;
+      }
+      ++shard.stats.misses;
+    }
+
+    std::string key = scratchKey;
+    result_ptr translation =
+        std::make_shared<const string_type>(render(msgType, pluralCount, args));
+    if (translation->empty()) {
+      return translation;  // Possibly a failure (with exceptions disabled), so not cached.
+    }
+
+    const std::lock_guard<std::mutex> lock{shard.mutex};
+    const auto inserted = shard.entries.emplace(std::move(key), Entry{translation, {}});
+    if (!inserted.second) {
+      return inserted.first->second.translation;  // Another thread cached it first.
+    }
+
+    shard.recency.push_front(&inserted.first->first);
+    inserted.first->second.recency = shard.recency.begin();
+    if (shard.entries.size() > options_.maxEntriesPerShard) {
+      // Note: Erase by iterator, as erasing by the key the entry owns would read
+      // the key while destroying it.
+      const auto oldest = shard.entries.find(*shard.recency.back());
+      shard.recency.pop_back();
+      shard.entries.erase(oldest);
+      ++shard.stats.evictions;
+    }
+    return translation;
+  }
+
+  std::shared_ptr<const Translator<CharT>> translator_;
+  CacheOptions options_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_CACHING_TRANSLATOR_HPP
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simple_tr8n/caching_translator.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace test_msgs {
+
+constexpr char kNoArgs[] = "test.no_args";
+constexpr char kHelloName[] = "test.hello_name";
+constexpr char kNumFiles[] = "test.num_files";
+
+}  // namespace test_msgs
+
+namespace {
+
+std::shared_ptr<const simple_tr8n::SimpleTranslator<char>> makeTranslator() {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kNoArgs, "Saved")
+      .add(test_msgs::kHelloName, "hello, %{personName}!")
+      .add(test_msgs::kNumFiles, {{0, "no files"}, {1, "1 file"}, {2, "%{num} files"}});
+  return std::make_shared<const simple_tr8n::SimpleTranslator<char>>(std::move(configs));
+}
+
+}  // namespace
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+
+TEST(CachingTranslatorTest, ShouldReturnCachedTranslations) {
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator()};
+
+  const auto first = translator.translateShared(test_msgs::kNoArgs);
+  const auto second = translator.translateShared(test_msgs::kNoArgs);
+  EXPECT_THAT(*first, Eq("Saved"));
+  EXPECT_THAT(second.get(), Eq(first.get()));
+
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName, {{"personName", "Amy"}}),
+      Eq("hello, Amy!"));
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName, {{"personName", "Bob"}}),
+      Eq("hello, Bob!"));
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName, {{"personName", "Amy"}}),
+      Eq("hello, Amy!"));
+
+  EXPECT_THAT(translator.translatePlural(test_msgs::kNumFiles, 1, {{"num", "1"}}), Eq("1 file"));
+  EXPECT_THAT(translator.translatePlural(test_msgs::kNumFiles, 3, {{"num", "3"}}), Eq("3 files"));
+  EXPECT_THAT(translator.translatePlural(test_msgs::kNumFiles, 1, {{"num", "1"}}), Eq("1 file"));
+
+  std::string out = "> ";
+  translator.translateTo(out, test_msgs::kNoArgs);
+  EXPECT_THAT(out, Eq("> Saved"));
+
+  const auto stats = translator.stats();
+  EXPECT_THAT(stats.hits, Eq(4u));
+  EXPECT_THAT(stats.misses, Eq(5u));
+  EXPECT_THAT(stats.size, Eq(5u));
+  EXPECT_THAT(stats.hitRate(), Eq(4.0 / 9.0));
+}
+
+TEST(CachingTranslatorTest, ShouldTranslateBatchFromCache) {
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator()};
+
+  const simple_tr8n::TransArgs<char> helloArgs{{"personName", "Amy"}};
+  const std::vector<simple_tr8n::TransRequest<char>> requests = {
+      {test_msgs::kHelloName, &helloArgs},
+      {test_msgs::kNoArgs},
+      {test_msgs::kHelloName, &helloArgs},
+  };
+  std::string out;
+  std::vector<std::size_t> offsets;
+  translator.translateBatch(requests, out, offsets);
+
+  EXPECT_THAT(out, Eq("hello, Amy!Savedhello, Amy!"));
+  EXPECT_THAT(offsets, ElementsAre(0u, 11u, 16u, 27u));
+  EXPECT_THAT(translator.stats().hits, Eq(1u));
+}
+
+TEST(CachingTranslatorTest, ShouldEvictLeastRecentlyUsed) {
+  simple_tr8n::CacheOptions options;
+  options.numShards = 1;
+  options.maxEntriesPerShard = 2;
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator(), options};
+
+  const auto amy = translator.translateShared(test_msgs::kHelloName, {{"personName", "Amy"}});
+  translator.translateShared(test_msgs::kHelloName, {{"personName", "Bob"}});
+  translator.translateShared(test_msgs::kHelloName, {{"personName", "Amy"}});
+  translator.translateShared(test_msgs::kHelloName, {{"personName", "Cat"}});  // Evicts Bob.
+
+  EXPECT_THAT(
+      translator.translateShared(test_msgs::kHelloName, {{"personName", "Amy"}}).get(),
+      Eq(amy.get()));
+  EXPECT_THAT(translator.stats().evictions, Eq(1u));
+  EXPECT_THAT(translator.stats().size, Eq(2u));
+
+  translator.translateShared(test_msgs::kHelloName, {{"personName", "Bob"}});
+  EXPECT_THAT(translator.stats().misses, Eq(4u));
+
+  translator.clear();
+  EXPECT_THAT(translator.stats().size, Eq(0u));
+  EXPECT_THAT(*amy, Eq("hello, Amy!"));  // Still valid after eviction.
+}
+
+TEST(CachingTranslatorTest, ShouldBypassCacheForManyArgs) {
+  simple_tr8n::CacheOptions options;
+  options.maxArgs = 1;
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator(), options};
+
+  const simple_tr8n::TransArgs<char> args{{"personName", "Amy"}, {"unused", "x"}};
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName, args), Eq("hello, Amy!"));
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName, args), Eq("hello, Amy!"));
+
+  EXPECT_THAT(translator.stats().hits, Eq(0u));
+  EXPECT_THAT(translator.stats().misses, Eq(2u));
+  EXPECT_THAT(translator.stats().size, Eq(0u));
+}
+
+TEST(CachingTranslatorTest, ShouldTranslateConcurrently) {
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator()};
+  const std::vector<std::string> names = {"Amy", "Bob", "Cat", "Dan"};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&translator, &names]() {
+      for (int j = 0; j < 1000; ++j) {
+        const std::string& name = names[j % names.size()];
+        EXPECT_THAT(translator.translate(test_msgs::kHelloName, {{"personName", name}}),
+            Eq("hello, " + name + "!"));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = translator.stats();
+  EXPECT_THAT(stats.hits + stats.misses, Eq(4000u));
+  EXPECT_THAT(stats.size, Eq(names.size()));
+}
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(CachingTranslatorTest, ShouldNotCacheErrors) {
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator()};
+
+  EXPECT_THROW(translator.translate(test_msgs::kHelloName), simple_tr8n::MissingArgException<char>);
+  EXPECT_THROW(translator.translate(test_msgs::kHelloName), simple_tr8n::MissingArgException<char>);
+  EXPECT_THAT(translator.stats().size, Eq(0u));
+}
+
+#else
+
+TEST(CachingTranslatorTest, ShouldNotCacheErrors) {
+  simple_tr8n::CachingTranslator<char> translator{makeTranslator()};
+
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName), Eq(""));
+  EXPECT_THAT(translator.translate("test.missing"), Eq(""));
+  EXPECT_THAT(translator.translatePlural(test_msgs::kNoArgs, 1, {}), Eq(""));
+  EXPECT_THAT(translator.stats().size, Eq(0u));
+  EXPECT_THAT(translator.stats().misses, Eq(3u));
+}
+
+#endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_CATALOG_HPP
+#define SIMPLE_TR8N_CATALOG_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "simple_tr8n/simple_translator.hpp"
+
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  #include "simple_tr8n/exceptions.hpp"
+#endif
+
+namespace simple_tr8n {
+namespace internal {
+
+/** Read-only memory mapping of a whole file. */
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+      ::UnmapViewOfFile(data_);
+    }
+#else
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  /** Maps the file at path. Returns false if it can't be opened or is empty. */
+  bool open(const std::string& path) {
+    Expects(data_ == nullptr);
+
+#ifdef _WIN32
+    const HANDLE file = ::CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+      const HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr) {
+        data_ = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        size_ = (data_ != nullptr) ? static_cast<std::size_t>(fileSize.QuadPart) : 0;
+        ::CloseHandle(mapping);  // The view keeps the mapping open.
+      }
+    }
+    ::CloseHandle(file);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+      const auto fileSize = static_cast<std::size_t>(fileStat.st_size);
+      void* const data = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+      if (data != MAP_FAILED) {
+        data_ = data;
+        size_ = fileSize;
+      }
+    }
+    ::close(fd);  // The mapping stays valid.
+#endif
+
+    return data_ != nullptr;
+  }
+
+  const void* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace internal
+
+/**
+ * Writes configs (freezing it, if not already frozen) to a binary catalog file
+ * that loadCatalog() can map. Returns false if the file can't be written (when
+ * exceptions are disabled).
+ */
+template<typename CharT>
+bool writeCatalog(MsgConfigs<CharT>& configs, const std::string& path) {
+  configs.freeze();
+  const std::string catalog = configs.toCatalog();
+
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  out.write(catalog.data(), static_cast<std::streamsize>(catalog.size()));
+  out.close();
+  if (!out) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+    throw CatalogException{path, "can't write catalog file"};
+#else
+    return false;
+#endif
+  }
+
+  return true;
+}
+
+/**
+ * Loads a binary catalog file written by writeCatalog() (or the catalog
+ * compiler tool) by memory-mapping it. Messages are used directly from the
+ * mapped pages rather than copied, so processes loading the same catalog
+ * share one copy of it in the OS page cache, and loading costs little more
+ * than building a small per-message index.
+ *
+ * Returns nullptr if the file can't be mapped or isn't a valid catalog of
+ * CharT messages for this machine (when exceptions are disabled). The file
+ * must not be modified while loaded; replace it by renaming a new file over
+ * it instead.
+ */
+template<typename CharT>
+std::unique_ptr<MsgConfigs<CharT>> loadCatalog(const std::string& path) {
+  auto file = std::make_shared<internal::MappedFile>();
+  if (!file->open(path)) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+    throw CatalogException{path, "can't map catalog file"};
+#else
+    return nullptr;
+#endif
+  }
+
+  auto configs = std::make_unique<MsgConfigs<CharT>>();
+  const void* const data = file->data();
+  const std::size_t size = file->size();
+  if (!configs->viewCatalog(data, size, std::move(file))) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+    throw CatalogException{path, "invalid catalog file"};
+#else
+    return nullptr;
+#endif
+  }
+
+  return configs;
+}
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_CATALOG_HPP
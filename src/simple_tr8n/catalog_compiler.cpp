@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Compiles a text or JSON catalog source (see parseCatalogFile()) into a binary
+// catalog file that loadCatalog() can memory-map.
+//
+// Usage: SimpleTr8n_CatalogCompiler <source-file> <catalog-file>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "simple_tr8n/catalog.hpp"
+#include "simple_tr8n/catalog_source.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace {
+
+int compile(const std::string& sourcePath, const std::string& catalogPath) {
+  simple_tr8n::MsgConfigs<char> configs;
+  std::string error;
+  if (!simple_tr8n::parseCatalogFile(sourcePath, configs, error)) {
+    std::cerr << error << "\n";
+    return EXIT_FAILURE;
+  }
+
+  if (!simple_tr8n::writeCatalog(configs, catalogPath)) {
+    std::cerr << catalogPath << ": can't write catalog file\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Compiled " << configs.size() << " messages to " << catalogPath << "\n";
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <source-file> <catalog-file>\n";
+    return EXIT_FAILURE;
+  }
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  try {
+    return compile(argv[1], argv[2]);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+#else
+  return compile(argv[1], argv[2]);
+#endif
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_CATALOG_FORMAT_HPP
+#define SIMPLE_TR8N_CATALOG_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "simple_tr8n/msg_template.hpp"
+
+namespace simple_tr8n {
+namespace internal {
+
+// Binary catalog format: a frozen MsgConfigs, laid out so that it can be used
+// in place (e.g. from a memory-mapped file) without parsing or copying.
+//
+// A catalog is a CatalogHeader followed by these sections, in order, each
+// starting at a multiple of kCatalogAlignment bytes from the start:
+//
+//   CatalogEntry[numEntries]       One per message type, by perfect hash slot.
+//   CatalogCase[numCases]          Plural cases of all entries.
+//   MsgSegment[numSegments]        Parsed segments of all cases.
+//   std::uint32_t[numPilots]       Perfect hash pilots (see PerfectHash).
+//   CharT[textSize]                All message types and message texts.
+//
+// All values are in the byte order of the machine that wrote the catalog, so
+// catalogs can only be shared between machines with the same byte order and
+// sizeof(CharT); readers reject any others.
+
+constexpr char kCatalogMagic[8] = {'S', 'T', 'R', '8', 'N', 'C', 'A', 'T'};
+constexpr std::uint32_t kCatalogVersion = 3;     // Adds CatalogEntry::boundArgsHash.
+constexpr std::uint32_t kMinCatalogVersion = 3;  // Oldest version readers accept.
+constexpr std::uint32_t kCatalogByteOrder = 0x01020304;
+constexpr std::size_t kCatalogAlignment = 8;
+
+struct CatalogHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t charSize;
+  std::uint32_t numEntries;
+  std::uint32_t numCases;
+  std::uint32_t numSegments;
+  std::uint32_t numPilots;
+  std::uint32_t reserved;
+  std::uint64_t textSize;  // In characters.
+  std::uint64_t hashSeed;
+  std::uint64_t keySetId;
+};
+
+struct CatalogEntry {
+  std::uint32_t msgTypeOffset;  // In characters, within the text section.
+  std::uint32_t msgTypeLength;
+  std::uint32_t firstCase;
+  std::uint32_t numCases;
+  std::int32_t numBoundArgs;
+  std::uint32_t numSlots;
+  std::uint64_t boundArgsHash;  // See MsgConfig::boundArgsHash().
+};
+
+struct CatalogCase {
+  std::int32_t count;  // See PluralCase::count() (and internal::categoryCount()).
+  std::uint32_t msgOffset;  // In characters, within the text section.
+  std::uint32_t msgLength;
+  std::uint32_t firstSegment;
+  std::uint32_t numSegments;
+};
+
+static_assert(std::is_trivially_copyable<CatalogHeader>::value, "CatalogHeader must be POD");
+static_assert(std::is_trivially_copyable<CatalogEntry>::value, "CatalogEntry must be POD");
+static_assert(std::is_trivially_copyable<CatalogCase>::value, "CatalogCase must be POD");
+static_assert(std::is_trivially_copyable<MsgSegment>::value, "MsgSegment must be POD");
+static_assert(sizeof(MsgSegment) == 3 * sizeof(std::uint32_t), "MsgSegment must not be padded");
+
+/** Rounds size up to a multiple of kCatalogAlignment. */
+inline std::uint64_t catalogAlign(std::uint64_t size) {
+  return (size + kCatalogAlignment - 1) / kCatalogAlignment * kCatalogAlignment;
+}
+
+/** Byte offsets of each catalog section, as determined by the header's counts. */
+struct CatalogLayout {
+  template<typename CharT>
+  static CatalogLayout of(const CatalogHeader& header) {
+    CatalogLayout layout;
+    layout.entries = catalogAlign(sizeof(CatalogHeader));
+    layout.cases = catalogAlign(layout.entries + header.numEntries * sizeof(CatalogEntry));
+    layout.segments = catalogAlign(layout.cases + header.numCases * sizeof(CatalogCase));
+    layout.pilots = catalogAlign(layout.segments + header.numSegments * sizeof(MsgSegment));
+    layout.text = catalogAlign(layout.pilots + header.numPilots * sizeof(std::uint32_t));
+    layout.size = layout.text + header.textSize * sizeof(CharT);
+    return layout;
+  }
+
+  std::uint64_t entries;
+  std::uint64_t cases;
+  std::uint64_t segments;
+  std::uint64_t pilots;
+  std::uint64_t text;
+  std::uint64_t size;  // Total size of the catalog.
+};
+
+}  // namespace internal
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_CATALOG_FORMAT_HPP
@@ -0,0 +1,568 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_CATALOG_SOURCE_HPP
+#define SIMPLE_TR8N_CATALOG_SOURCE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace simple_tr8n {
+namespace internal {
+
+/** Returns str without leading and trailing spaces and tabs. */
+inline std::string trimSource(const std::string& str) {
+  const std::size_t begin = str.find_first_not_of(" \t");
+  if (begin == std::string::npos) {
+    return std::string{};
+  }
+  const std::size_t end = str.find_last_not_of(" \t");
+  return str.substr(begin, end + 1 - begin);
+}
+
+/** Replaces \n, \t and \\ escapes in str. Returns false on any other escape. */
+inline bool unescapeSource(std::string& str) {
+  std::string result;
+  result.reserve(str.size());
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    if (str[i] != '\\') {
+      result.push_back(str[i]);
+      continue;
+    }
+
+    if (++i == str.size()) {
+      return false;
+    }
+    switch (str[i]) {
+      case 'n':
+        result.push_back('\n');
+        break;
+      case 't':
+        result.push_back('\t');
+        break;
+      case '\\':
+        result.push_back('\\');
+        break;
+      default:
+        return false;
+    }
+  }
+
+  str = std::move(result);
+  return true;
+}
+
+/**
+ * Parses a plural case key: a count (e.g. "2") or a CLDR plural category name
+ * (e.g. "one"). Returns false if invalid.
+ */
+inline bool parseCaseKey(const std::string& key, int& count) {
+  PluralCategory category = PluralCategory::kOther;
+  if (parsePluralCategory(key, category)) {
+    count = categoryCount(category);
+    return true;
+  }
+  if (key.empty() || key.size() > 9 || key.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  count = std::stoi(key);
+  return true;
+}
+
+/**
+ * Adds parsed messages to configs, checking that message types are unique and
+ * that the plural cases of each message are in order (shared by all catalog
+ * source formats).
+ */
+class CatalogBuilder {
+public:
+  explicit CatalogBuilder(MsgConfigs<char>& configs) : configs_{configs} {}
+
+  ~CatalogBuilder() = default;
+
+  CatalogBuilder(const CatalogBuilder&) = delete;
+  CatalogBuilder& operator=(const CatalogBuilder&) = delete;
+
+  CatalogBuilder(CatalogBuilder&&) = delete;
+  CatalogBuilder& operator=(CatalogBuilder&&) = delete;
+
+  /**
+   * Adds a non-plural message (if count is kNoCount) or one plural case.
+   * Consecutive plural cases of the same message type are collected into one
+   * message. Returns a description of the problem if invalid, else nullptr.
+   */
+  const char* add(std::string msgType, int count, std::string msg) {
+    if (msgType.empty()) {
+      return "missing msgType";
+    }
+
+    if (count != kNoCount && msgType == pluralMsgType_ && !pluralCases_.empty()) {
+      const PluralCase<char>& lastCase = pluralCases_.back();
+      if (isCategoryCount(count)) {
+        for (const auto& msgCase : pluralCases_) {
+          if (msgCase.count() == count) {
+            return "duplicate plural category";
+          }
+        }
+      } else if (lastCase.hasCategory()) {
+        return "plural counts must precede plural categories";
+      } else if (count <= lastCase.count()) {
+        return "plural counts must be in ascending order";
+      }
+      pluralCases_.emplace_back(count, std::move(msg));
+      return nullptr;
+    }
+
+    endMsg();
+    if (configs_.has(msgType)) {
+      return "duplicate msgType";
+    }
+
+    if (count == kNoCount) {
+      configs_.add(msgType, msg);
+    } else {
+      pluralMsgType_ = std::move(msgType);
+      pluralCases_.emplace_back(count, std::move(msg));
+    }
+    return nullptr;
+  }
+
+  /** Adds any plural cases collected so far, so later ones start a new message. */
+  void endMsg() {
+    if (!pluralCases_.empty()) {
+      configs_.add(pluralMsgType_, std::move(pluralCases_));
+      pluralCases_.clear();
+    }
+  }
+
+private:
+  MsgConfigs<char>& configs_;
+  std::string pluralMsgType_;
+  std::vector<PluralCase<char>> pluralCases_;
+};
+
+}  // namespace internal
+
+/**
+ * Parses a text catalog source (UTF-8) into configs. Each non-blank line not
+ * starting with # configures one message or plural case:
+ *
+ *     # Comment.
+ *     your_project.hello_name = hello, %{personName}!
+ *     your_project.fish_count[0] = you have no fish
+ *     your_project.fish_count[1] = you have a fish
+ *     your_project.fish_count[2] = you have %{fishCount} fish
+ *     your_project.apple_count[0] = you have no apples
+ *     your_project.apple_count[one] = you have %{appleCount} apple
+ *     your_project.apple_count[other] = you have %{appleCount} apples
+ *
+ * Spaces around message types and texts are ignored; texts may use \n, \t and
+ * \\ escapes. The plural cases of a message must be on consecutive lines, in
+ * ascending count order, followed by any cases for CLDR plural categories
+ * (zero, one, two, few, many or other; see PluralCase).
+ *
+ * Returns false, setting error to a description including the line number, if
+ * the source is invalid (in which case configs may be partially filled).
+ */
+inline bool parseCatalogSource(std::istream& in, MsgConfigs<char>& configs, std::string& error) {
+  internal::CatalogBuilder builder{configs};
+
+  std::string line;
+  for (int lineNum = 1; std::getline(in, line); ++lineNum) {
+    const auto fail = [&](const char* problem) {
+      error = "line " + std::to_string(lineNum) + ": " + problem;
+      return false;
+    };
+
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();  // Allow Windows line endings.
+    }
+    const std::string trimmed = internal::trimSource(line);
+    if (trimmed.empty() || trimmed[0] == '#') {
+      continue;
+    }
+
+    const std::size_t equals = trimmed.find('=');
+    if (equals == std::string::npos) {
+      return fail("expected msgType = message");
+    }
+    std::string msgType = internal::trimSource(trimmed.substr(0, equals));
+    std::string msg = internal::trimSource(trimmed.substr(equals + 1));
+    if (!internal::unescapeSource(msg)) {
+      return fail("invalid escape sequence");
+    }
+
+    // Plural case: msgType[count] = message, or msgType[category] = message
+    int count = internal::kNoCount;
+    if (!msgType.empty() && msgType.back() == ']') {
+      const std::size_t open = msgType.rfind('[');
+      const std::string caseKey =
+          (open == std::string::npos) ? "" : msgType.substr(open + 1, msgType.size() - open - 2);
+      if (!internal::parseCaseKey(caseKey, count)) {
+        return fail("invalid plural count");
+      }
+      msgType = internal::trimSource(msgType.substr(0, open));
+    }
+
+    if (const char* problem = builder.add(std::move(msgType), count, std::move(msg))) {
+      return fail(problem);
+    }
+  }
+
+  builder.endMsg();
+  return true;
+}
+
+namespace internal {
+
+/**
+ * Streaming reader for the tokens of a JSON catalog source (see
+ * parseCatalogJson()), reading straight from the stream's buffer.
+ */
+class JsonSourceReader {
+public:
+  explicit JsonSourceReader(std::istream& in) : buf_{*in.rdbuf()} {}
+
+  ~JsonSourceReader() = default;
+
+  JsonSourceReader(const JsonSourceReader&) = delete;
+  JsonSourceReader& operator=(const JsonSourceReader&) = delete;
+
+  JsonSourceReader(JsonSourceReader&&) = delete;
+  JsonSourceReader& operator=(JsonSourceReader&&) = delete;
+
+  /** Current line number, for error descriptions. */
+  int line() const { return line_; }
+
+  /** Skips whitespace, then returns whether the input is at its end. */
+  bool atEnd() { return peek() == kEof; }
+
+  /** Skips whitespace, then consumes c if it's next. Returns whether it was. */
+  bool consume(char c) {
+    if (peek() != c) {
+      return false;
+    }
+    buf_.sbumpc();
+    return true;
+  }
+
+  /**
+   * Skips whitespace, then reads a string into out (decoding escapes, with
+   * \u escapes as UTF-8). Returns a description of the problem if invalid,
+   * else nullptr.
+   */
+  const char* readString(std::string& out) {
+    if (!consume('"')) {
+      return "expected string";
+    }
+
+    out.clear();
+    for (;;) {
+      const int c = buf_.sbumpc();
+      if (c == '"') {
+        return nullptr;
+      }
+      if (c == kEof || c == '\n') {
+        return "unterminated string";
+      }
+      if (c != '\\') {
+        out.push_back(static_cast<char>(c));
+        continue;
+      }
+
+      switch (buf_.sbumpc()) {
+        case '"':
+          out.push_back('"');
+          break;
+        case '\\':
+          out.push_back('\\');
+          break;
+        case '/':
+          out.push_back('/');
+          break;
+        case 'b':
+          out.push_back('\b');
+          break;
+        case 'f':
+          out.push_back('\f');
+          break;
+        case 'n':
+          out.push_back('\n');
+          break;
+        case 'r':
+          out.push_back('\r');
+          break;
+        case 't':
+          out.push_back('\t');
+          break;
+        case 'u':
+          if (!readCodePoint(out)) {
+            return "invalid \\u escape sequence";
+          }
+          break;
+        default:
+          return "invalid escape sequence";
+      }
+    }
+  }
+
+private:
+  static constexpr int kEof = std::char_traits<char>::eof();
+
+  int peek() {
+    for (;;) {
+      const int c = buf_.sgetc();
+      if (c == '\n') {
+        ++line_;
+      } else if (c != ' ' && c != '\t' && c != '\r') {
+        return c;
+      }
+      buf_.sbumpc();
+    }
+  }
+
+  /** Reads the 4 hex digits of a \u escape. Returns -1 if invalid. */
+  long readHex4() {
+    long value = 0;
+    for (int i = 0; i < 4; ++i) {
+      const int c = buf_.sbumpc();
+      const int digit = (c >= '0' && c <= '9')   ? c - '0'
+                        : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                        : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                                 : -1;
+      if (digit < 0) {
+        return -1;
+      }
+      value = value * 16 + digit;
+    }
+    return value;
+  }
+
+  /** Reads the rest of a \u escape (and its low surrogate, if any) as UTF-8. */
+  bool readCodePoint(std::string& out) {
+    long codePoint = readHex4();
+    if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+      return false;  // Unpaired low surrogate.
+    }
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+      if (buf_.sbumpc() != '\\' || buf_.sbumpc() != 'u') {
+        return false;
+      }
+      const long low = readHex4();
+      if (low < 0xDC00 || low > 0xDFFF) {
+        return false;
+      }
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    }
+    if (codePoint < 0) {
+      return false;
+    }
+
+    if (codePoint < 0x80) {
+      out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+      out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+      out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+      out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    return true;
+  }
+
+  std::streambuf& buf_;
+  int line_ = 1;
+};
+
+}  // namespace internal
+
+/**
+ * Parses a JSON catalog source (UTF-8) into configs, streaming it without
+ * building any intermediate document. The source is one object mapping each
+ * message type to its text, or to an object mapping plural case keys (as in
+ * parseCatalogSource()) to texts:
+ *
+ *     {
+ *       "your_project.hello_name": "hello, %{personName}!",
+ *       "your_project.apple_count": {
+ *         "0": "you have no apples",
+ *         "one": "you have %{appleCount} apple",
+ *         "other": "you have %{appleCount} apples"
+ *       }
+ *     }
+ *
+ * Plural cases must be in the same order as for parseCatalogSource().
+ *
+ * Returns false, setting error to a description including the line number, if
+ * the source is invalid (in which case configs may be partially filled).
+ */
+inline bool parseCatalogJson(std::istream& in, MsgConfigs<char>& configs, std::string& error) {
+  internal::JsonSourceReader reader{in};
+  internal::CatalogBuilder builder{configs};
+  const auto fail = [&](const char* problem) {
+    error = "line " + std::to_string(reader.line()) + ": " + problem;
+    return false;
+  };
+
+  if (!reader.consume('{')) {
+    return fail("expected {");
+  }
+
+  std::string msgType;
+  std::string caseKey;
+  std::string msg;
+  bool more = !reader.consume('}');
+  while (more) {
+    if (const char* problem = reader.readString(msgType)) {
+      return fail(problem);
+    }
+    if (!reader.consume(':')) {
+      return fail("expected :");
+    }
+
+    if (reader.consume('{')) {
+      do {
+        if (const char* problem = reader.readString(caseKey)) {
+          return fail(problem);
+        }
+        int count = internal::kNoCount;
+        if (!internal::parseCaseKey(caseKey, count)) {
+          return fail("invalid plural count");
+        }
+        if (!reader.consume(':')) {
+          return fail("expected :");
+        }
+        if (const char* problem = reader.readString(msg)) {
+          return fail(problem);
+        }
+        if (const char* problem = builder.add(msgType, count, std::move(msg))) {
+          return fail(problem);
+        }
+      } while (reader.consume(','));
+
+      if (!reader.consume('}')) {
+        return fail("expected , or }");
+      }
+      builder.endMsg();
+    } else {
+      if (const char* problem = reader.readString(msg)) {
+        return fail(problem);
+      }
+      if (const char* problem =
+              builder.add(std::move(msgType), internal::kNoCount, std::move(msg))) {
+        return fail(problem);
+      }
+    }
+
+    more = reader.consume(',');
+    if (!more && !reader.consume('}')) {
+      return fail("expected , or }");
+    }
+  }
+
+  if (!reader.atEnd()) {
+    return fail("unexpected text after catalog object");
+  }
+  return true;
+}
+
+/**
+ * Parses the catalog source file at path into configs: as JSON (see
+ * parseCatalogJson()) if path ends with ".json", else as a text catalog source
+ * (see parseCatalogSource()). Error descriptions start with the path.
+ */
+inline bool parseCatalogFile(
+    const std::string& path, MsgConfigs<char>& configs, std::string& error) {
+  std::ifstream in{path, std::ios::binary};
+  if (!in) {
+    error = path + ": can't read source file";
+    return false;
+  }
+
+  const std::string jsonExt = ".json";
+  const bool isJson = (path.size() >= jsonExt.size()) &&
+                      (path.compare(path.size() - jsonExt.size(), jsonExt.size(), jsonExt) == 0);
+  const bool ok =
+      isJson ? parseCatalogJson(in, configs, error) : parseCatalogSource(in, configs, error);
+  if (!ok) {
+    error = path + ": " + error;
+  }
+  return ok;
+}
+
+/**
+ * Parses and freezes the catalog source files at paths (e.g. one per locale of
+ * a deployment; see parseCatalogFile()) in parallel, on up to numThreads
+ * threads including the calling one (0 for one per hardware thread).
+ *
+ * Returns the configs for each path, in the same order, with nullptr for each
+ * that failed. Resizes errors to match, with the error description for each
+ * failed path (and an empty string for the rest).
+ */
+inline std::vector<std::unique_ptr<MsgConfigs<char>>> parseCatalogFiles(
+    const std::vector<std::string>& paths, std::vector<std::string>& errors,
+    unsigned numThreads = 0) {
+  std::vector<std::unique_ptr<MsgConfigs<char>>> results(paths.size());
+  errors.assign(paths.size(), std::string{});
+
+  const auto parse = [&](std::size_t i) {
+    auto configs = std::make_unique<MsgConfigs<char>>();
+    if (parseCatalogFile(paths[i], *configs, errors[i])) {
+      configs->freeze();
+      results[i] = std::move(configs);
+    }
+  };
+
+  std::atomic<std::size_t> next{0};
+  const auto work = [&]() {
+    for (std::size_t i = next++; i < paths.size(); i = next++) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+      try {
+        parse(i);
+      } catch (const std::exception& e) {
+        errors[i] = paths[i] + ": " + e.what();
+      }
+#else
+      parse(i);
+#endif
+    }
+  };
+
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, paths.size()));
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < numThreads; ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_CATALOG_SOURCE_HPP
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/catalog_source.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace {
+
+constexpr std::size_t kNumMsgs = 50000;
+constexpr std::size_t kNumLocales = 8;
+
+std::string msgType(std::size_t i) {
+  return "your_project.some.long.namespace.messages.msg_" + std::to_string(i);
+}
+
+// Catalog source with numMsgs messages, every tenth of them plural.
+std::string makeSource(std::size_t numMsgs, bool json) {
+  std::ostringstream out;
+  out << (json ? "{\n" : "");
+  for (std::size_t i = 0; i < numMsgs; ++i) {
+    const std::string type = msgType(i);
+    const bool last = (i + 1 == numMsgs);
+    if (i % 10 != 0) {
+      if (json) {
+        out << "  \"" << type << "\": \"A message with a %{arg} argument\"" << (last ? "" : ",")
+            << "\n";
+      } else {
+        out << type << " = A message with a %{arg} argument\n";
+      }
+    } else if (json) {
+      out << "  \"" << type << "\": {\"0\": \"No files\", \"one\": \"%{num} file\", "
+          << "\"other\": \"%{num} files\"}" << (last ? "" : ",") << "\n";
+    } else {
+      out << type << "[0] = No files\n"
+          << type << "[one] = %{num} file\n"
+          << type << "[other] = %{num} files\n";
+    }
+  }
+  out << (json ? "}\n" : "");
+  return out.str();
+}
+
+// Parses (without freezing) a catalog source of kNumMsgs messages in memory.
+template<bool Json>
+void BM_ParseSource(benchmark::State& state) {
+  const std::string source = makeSource(kNumMsgs, Json);
+  for (auto _ : state) {
+    std::istringstream in{source};
+    simple_tr8n::MsgConfigs<char> configs;
+    std::string error;
+    const bool ok = Json ? simple_tr8n::parseCatalogJson(in, configs, error)
+                         : simple_tr8n::parseCatalogSource(in, configs, error);
+    if (!ok) {
+      state.SkipWithError(error.c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNumMsgs));
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(source.size()));
+}
+BENCHMARK_TEMPLATE(BM_ParseSource, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ParseSource, true)->Unit(benchmark::kMillisecond);
+
+// Parses and freezes kNumLocales JSON files of kNumMsgs messages each, with the
+// given number of threads.
+void BM_ParseFiles(benchmark::State& state) {
+  const std::string source = makeSource(kNumMsgs, true);
+  std::vector<std::string> paths;
+  for (std::size_t i = 0; i < kNumLocales; ++i) {
+    paths.push_back("simple_tr8n_catalog_source_benchmark_" + std::to_string(i) + ".json");
+    std::ofstream{paths.back(), std::ios::binary} << source;
+  }
+
+  for (auto _ : state) {
+    std::vector<std::string> errors;
+    const auto configs =
+        simple_tr8n::parseCatalogFiles(paths, errors, static_cast<unsigned>(state.range(0)));
+    if (configs[0] == nullptr) {
+      state.SkipWithError(errors[0].c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNumLocales * kNumMsgs));
+
+  for (const auto& path : paths) {
+    std::remove(path.c_str());
+  }
+}
+BENCHMARK(BM_ParseFiles)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(
+    benchmark::kMillisecond);
+
+}  // namespace
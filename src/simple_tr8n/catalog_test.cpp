@@ -0,0 +1,517 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/catalog.hpp"
+#include "simple_tr8n/catalog_format.hpp"
+#include "simple_tr8n/catalog_source.hpp"
+#include "simple_tr8n/catalog_validator.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  #include "simple_tr8n/exceptions.hpp"
+#endif
+
+namespace test_msgs {
+
+constexpr char kNoArgs[] = "test.no_args";
+constexpr char kHelloName[] = "test.hello_name";
+constexpr char kFishCount[] = "test.fish_count";
+
+constexpr auto kSum = simple_tr8n::makeMsgDescriptor("test.sum", "a", "b");
+
+}  // namespace test_msgs
+
+namespace {
+
+void addTestMsgs(simple_tr8n::MsgConfigs<char>& configs) {
+  configs.add(test_msgs::kNoArgs, "A simple message with no arguments")
+      .add(test_msgs::kHelloName, "hello, %{personName}!")
+      .add(
+          test_msgs::kFishCount,
+          {
+              {0, "%{personName}, you have no fish"},
+              {1, "%{personName}, you have a fish"},
+              {2, "%{personName}, you have %{fishCount} fish"},
+          })
+      .add(test_msgs::kSum, "%{a} + %{b}");
+}
+
+// Copies a catalog to 8-byte aligned memory.
+std::vector<std::uint64_t> alignedCopy(const std::string& catalog) {
+  std::vector<std::uint64_t> result((catalog.size() + 7) / 8);
+  if (!catalog.empty()) {
+    std::memcpy(result.data(), catalog.data(), catalog.size());
+  }
+  return result;
+}
+
+}  // namespace
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::IsNull;
+using ::testing::NotNull;
+using ::testing::UnorderedElementsAre;
+
+TEST(CatalogTest, ShouldRoundTripThroughFile) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  addTestMsgs(*configs);
+  const std::string path = ::testing::TempDir() + "simple_tr8n_catalog_test.catalog";
+  ASSERT_TRUE(simple_tr8n::writeCatalog(*configs, path));
+  const simple_tr8n::SimpleTranslator<char> original{std::move(configs)};
+
+  auto loadedConfigs = simple_tr8n::loadCatalog<char>(path);
+  ASSERT_THAT(loadedConfigs, NotNull());
+  EXPECT_TRUE(loadedConfigs->frozen());
+  EXPECT_THAT(loadedConfigs->size(), Eq(4u));
+  const simple_tr8n::SimpleTranslator<char> loaded{std::move(loadedConfigs)};
+
+  EXPECT_THAT(loaded.translate(test_msgs::kNoArgs), Eq("A simple message with no arguments"));
+  EXPECT_THAT(
+      loaded.translate(test_msgs::kHelloName, {{"personName", "Amy"}}), Eq("hello, Amy!"));
+  EXPECT_THAT(
+      loaded.translatePlural(test_msgs::kFishCount, 1, {{"personName", "Amy"}}),
+      Eq("Amy, you have a fish"));
+  EXPECT_THAT(
+      loaded.translatePlural(
+          test_msgs::kFishCount, 7, {{"personName", "Amy"}, {"fishCount", "7"}}),
+      Eq("Amy, you have 7 fish"));
+  EXPECT_THAT(loaded.translate(test_msgs::kSum, "1", "2"), Eq("1 + 2"));
+
+  // Handles resolved by the original are valid for the loaded catalog.
+  const auto msgId = original.resolve(test_msgs::kHelloName);
+  EXPECT_THAT(loaded.resolve(test_msgs::kHelloName).keySetId(), Eq(msgId.keySetId()));
+  EXPECT_THAT(loaded.translate(msgId, {{"personName", "Bo"}}), Eq("hello, Bo!"));
+}
+
+TEST(CatalogTest, ShouldViewWideCharCatalogsInMemory) {
+  simple_tr8n::MsgConfigs<wchar_t> configs;
+  configs.add(L"test.hello_name", L"hello, %{personName}!");
+  configs.freeze();
+  const auto catalog = alignedCopy(configs.toCatalog());
+
+  simple_tr8n::MsgConfigs<wchar_t> viewed;
+  ASSERT_TRUE(viewed.viewCatalog(catalog.data(), catalog.size() * 8, nullptr));
+  EXPECT_THAT(viewed.get(L"test.hello_name").onlyCase().msg(), Eq(L"hello, %{personName}!"));
+}
+
+TEST(CatalogTest, ShouldKeepBoundArgKeyOrder) {
+  simple_tr8n::MsgConfigs<char> configs;
+  addTestMsgs(configs);
+  configs.freeze();
+  const std::string catalog = configs.toCatalog();
+  const auto aligned = alignedCopy(catalog);
+  auto viewed = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  ASSERT_TRUE(viewed->viewCatalog(aligned.data(), catalog.size(), nullptr));
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(viewed)};
+
+  // Same message type and arity as the descriptor the catalog was built with,
+  // but with its argument keys reordered (e.g. a stale catalog).
+  constexpr auto kReorderedSum = simple_tr8n::makeMsgDescriptor("test.sum", "b", "a");
+  EXPECT_THAT(translator.translate(test_msgs::kSum, "1", "2"), Eq("1 + 2"));
+  EXPECT_THAT(translator.translate(kReorderedSum, "2", "1"), Eq("1 + 2"));
+}
+
+TEST(CatalogTest, ShouldRejectInvalidCatalogs) {
+  simple_tr8n::MsgConfigs<char> configs;
+  addTestMsgs(configs);
+  configs.freeze();
+  const std::string catalog = configs.toCatalog();
+
+  const auto viewFails = [](const std::string& bytes) {
+    const auto aligned = alignedCopy(bytes);
+    simple_tr8n::MsgConfigs<char> viewed;
+    const bool valid = viewed.viewCatalog(aligned.data(), bytes.size(), nullptr);
+    return !valid && !viewed.frozen() && (viewed.size() == 0);
+  };
+
+  EXPECT_TRUE(viewFails(""));
+  EXPECT_TRUE(viewFails(catalog.substr(0, catalog.size() - 1)));
+  EXPECT_TRUE(viewFails("X" + catalog.substr(1)));
+
+  // Out of range message text offset.
+  simple_tr8n::internal::CatalogHeader header;
+  std::memcpy(&header, catalog.data(), sizeof(header));
+  const auto layout = simple_tr8n::internal::CatalogLayout::of<char>(header);
+  std::string corrupt = catalog;
+  simple_tr8n::internal::CatalogCase firstCase;
+  std::memcpy(&firstCase, &corrupt[layout.cases], sizeof(firstCase));
+  firstCase.msgOffset = static_cast<std::uint32_t>(header.textSize);
+  std::memcpy(&corrupt[layout.cases], &firstCase, sizeof(firstCase));
+  EXPECT_TRUE(viewFails(corrupt));
+
+  // Unknown plural category.
+  corrupt = catalog;
+  std::memcpy(&firstCase, &corrupt[layout.cases], sizeof(firstCase));
+  firstCase.count = simple_tr8n::internal::categoryCount(simple_tr8n::PluralCategory::kOther) - 1;
+  std::memcpy(&corrupt[layout.cases], &firstCase, sizeof(firstCase));
+  EXPECT_TRUE(viewFails(corrupt));
+
+  // Older catalog version, without bound argument key hashes.
+  corrupt = catalog;
+  header.version = 2;
+  std::memcpy(&corrupt[0], &header, sizeof(header));
+  EXPECT_TRUE(viewFails(corrupt));
+
+  // Wrong character type.
+  const auto aligned = alignedCopy(catalog);
+  simple_tr8n::MsgConfigs<wchar_t> wideConfigs;
+  EXPECT_FALSE(wideConfigs.viewCatalog(aligned.data(), catalog.size(), nullptr));
+}
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(CatalogTest, ShouldHandleErrorsLoading) {
+  EXPECT_THROW(
+      simple_tr8n::loadCatalog<char>(::testing::TempDir() + "missing.catalog"),
+      simple_tr8n::CatalogException);
+}
+
+#else  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(CatalogTest, ShouldHandleErrorsLoading) {
+  EXPECT_THAT(
+      simple_tr8n::loadCatalog<char>(::testing::TempDir() + "missing.catalog"), IsNull());
+}
+
+#endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(CatalogSourceTest, ShouldParseSource) {
+  std::istringstream source{
+      "# Comment line.\n"
+      "\n"
+      "test.no_args = A simple message with no arguments\n"
+      "  test.hello_name=hello,\\t%{personName}!\\n  \r\n"
+      "test.fish_count[0] = no fish\n"
+      "test.fish_count[1] = a fish\n"
+      "test.fish_count[2] = %{fishCount} fish = many fish\n"};
+
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  std::string error;
+  ASSERT_TRUE(simple_tr8n::parseCatalogSource(source, *configs, error)) << error;
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+
+  EXPECT_THAT(translator.translate(test_msgs::kNoArgs), Eq("A simple message with no arguments"));
+  EXPECT_THAT(
+      translator.translate(test_msgs::kHelloName, {{"personName", "Amy"}}),
+      Eq("hello,\tAmy!\n"));
+  EXPECT_THAT(translator.translatePlural(test_msgs::kFishCount, 0, {}), Eq("no fish"));
+  EXPECT_THAT(
+      translator.translatePlural(test_msgs::kFishCount, 5, {{"fishCount", "5"}}),
+      Eq("5 fish = many fish"));
+}
+
+TEST(CatalogSourceTest, ShouldParsePluralCategories) {
+  std::istringstream source{
+      "test.fish_count[0] = no fish\n"
+      "test.fish_count[one] = %{fishCount} fish (one)\n"
+      "test.fish_count[few] = %{fishCount} fish (few)\n"
+      "test.fish_count[other] = %{fishCount} fish (other)\n"};
+
+  simple_tr8n::MsgConfigs<char> configs;
+  std::string error;
+  ASSERT_TRUE(simple_tr8n::parseCatalogSource(source, configs, error)) << error;
+  configs.freeze();
+
+  // Category cases survive a round trip through a binary catalog.
+  const std::string catalog = configs.toCatalog();
+  const auto aligned = alignedCopy(catalog);
+  auto viewed = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  ASSERT_TRUE(viewed->viewCatalog(aligned.data(), catalog.size(), nullptr));
+  viewed->setPluralRules(simple_tr8n::PluralRules::forLanguage("ru"));
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(viewed)};
+
+  const auto translate = [&translator](int count) {
+    return translator.translatePlural(
+        test_msgs::kFishCount, count, {{"fishCount", std::to_string(count)}});
+  };
+  EXPECT_THAT(translate(0), Eq("no fish"));
+  EXPECT_THAT(translate(21), Eq("21 fish (one)"));
+  EXPECT_THAT(translate(3), Eq("3 fish (few)"));
+  EXPECT_THAT(translate(11), Eq("11 fish (other)"));  // many, which has no case.
+}
+
+TEST(CatalogSourceTest, ShouldReportSourceErrors) {
+  const auto parseError = [](const char* text) {
+    std::istringstream source{text};
+    simple_tr8n::MsgConfigs<char> configs;
+    std::string error;
+    EXPECT_FALSE(simple_tr8n::parseCatalogSource(source, configs, error));
+    return error;
+  };
+
+  EXPECT_THAT(parseError("a = 1\nno equals sign\n"), Eq("line 2: expected msgType = message"));
+  EXPECT_THAT(parseError("a = 1\na = 2\n"), Eq("line 2: duplicate msgType"));
+  EXPECT_THAT(
+      parseError("a[1] = 1\na[0] = 0\n"), Eq("line 2: plural counts must be in ascending order"));
+  EXPECT_THAT(parseError("a[1] = 1\nb = 2\na[2] = 2\n"), Eq("line 3: duplicate msgType"));
+  EXPECT_THAT(parseError("a[x] = 1\n"), Eq("line 1: invalid plural count"));
+  EXPECT_THAT(parseError("a[one] = 1\na[one] = 2\n"), Eq("line 2: duplicate plural category"));
+  EXPECT_THAT(
+      parseError("a[one] = 1\na[0] = 0\n"),
+      Eq("line 2: plural counts must precede plural categories"));
+  EXPECT_THAT(parseError(" = 1\n"), Eq("line 1: missing msgType"));
+  EXPECT_THAT(parseError("a = \\q\n"), Eq("line 1: invalid escape sequence"));
+}
+
+TEST(CatalogSourceTest, ShouldParseJson) {
+  std::istringstream source{
+      "{\n"
+      "  \"test.no_args\": \"A simple message with no arguments\",\n"
+      "  \"test.hello_name\" : \"hello,\\t%{personName}! \\u00e9\\ud83d\\ude00\\\"\\\\\\/\",\r\n"
+      "  \"test.fish_count\": {\"0\": \"no fish\", \"one\": \"%{fishCount} fish (one)\",\n"
+      "                      \"other\": \"%{fishCount} fish\"}\n"
+      "}\n"};
+
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  std::string error;
+  ASSERT_TRUE(simple_tr8n::parseCatalogJson(source, *configs, error)) << error;
+  configs->setPluralRules(simple_tr8n::PluralRules::forLanguage("en"));
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+
+  EXPECT_THAT(translator.translate(test_msgs::kNoArgs), Eq("A simple message with no arguments"));
+  EXPECT_THAT(
+      translator.translate(test_msgs::kHelloName, {{"personName", "Amy"}}),
+      Eq("hello,\tAmy! \xC3\xA9\xF0\x9F\x98\x80\"\\/"));
+  EXPECT_THAT(translator.translatePlural(test_msgs::kFishCount, 0, {}), Eq("no fish"));
+  EXPECT_THAT(
+      translator.translatePlural(test_msgs::kFishCount, "fishCount", {{"fishCount", 1}}),
+      Eq("1 fish (one)"));
+  EXPECT_THAT(
+      translator.translatePlural(test_msgs::kFishCount, "fishCount", {{"fishCount", 5}}),
+      Eq("5 fish"));
+
+  std::istringstream emptySource{" {} "};
+  simple_tr8n::MsgConfigs<char> emptyConfigs;
+  EXPECT_TRUE(simple_tr8n::parseCatalogJson(emptySource, emptyConfigs, error)) << error;
+  EXPECT_THAT(emptyConfigs.size(), Eq(0u));
+}
+
+TEST(CatalogSourceTest, ShouldReportJsonErrors) {
+  const auto parseError = [](const char* text) {
+    std::istringstream source{text};
+    simple_tr8n::MsgConfigs<char> configs;
+    std::string error;
+    EXPECT_FALSE(simple_tr8n::parseCatalogJson(source, configs, error));
+    return error;
+  };
+
+  EXPECT_THAT(parseError("[]"), Eq("line 1: expected {"));
+  EXPECT_THAT(parseError("{\"a\": \"1\",\n\"a\": \"2\"}"), Eq("line 2: duplicate msgType"));
+  EXPECT_THAT(
+      parseError("{\"a\": {\"1\": \"1\"},\n\"a\": {\"2\": \"2\"}}"),
+      Eq("line 2: duplicate msgType"));
+  EXPECT_THAT(
+      parseError("{\"a\": {\"1\": \"1\", \"0\": \"0\"}}"),
+      Eq("line 1: plural counts must be in ascending order"));
+  EXPECT_THAT(parseError("{\"a\": {\"x\": \"1\"}}"), Eq("line 1: invalid plural count"));
+  EXPECT_THAT(parseError("{\"a\": {}}"), Eq("line 1: expected string"));
+  EXPECT_THAT(parseError("{\"a\" \"1\"}"), Eq("line 1: expected :"));
+  EXPECT_THAT(parseError("{\"a\": 1}"), Eq("line 1: expected string"));
+  EXPECT_THAT(parseError("{\"a\": \"1\" \"b\": \"2\"}"), Eq("line 1: expected , or }"));
+  EXPECT_THAT(parseError("{\"a\": \"1\"} x"), Eq("line 1: unexpected text after catalog object"));
+  EXPECT_THAT(parseError("{\"a\": \"1"), Eq("line 1: unterminated string"));
+  EXPECT_THAT(parseError("{\"a\": \"\\q\"}"), Eq("line 1: invalid escape sequence"));
+  EXPECT_THAT(parseError("{\"a\": \"\\ud83d\"}"), Eq("line 1: invalid \\u escape sequence"));
+  EXPECT_THAT(parseError("{\"\": \"1\"}"), Eq("line 1: missing msgType"));
+}
+
+TEST(CatalogSourceTest, ShouldParseFilesInParallel) {
+  const std::string dir = ::testing::TempDir();
+  std::vector<std::string> paths;
+  for (int i = 0; i < 6; ++i) {
+    const bool isJson = (i % 2 == 0);
+    paths.push_back(
+        dir + "simple_tr8n_catalog_source_test_" + std::to_string(i) + (isJson ? ".json" : ".txt"));
+    std::ofstream out{paths.back(), std::ios::binary};
+    const std::string msg = "hello " + std::to_string(i) + ", %{personName}!";
+    if (isJson) {
+      out << "{\"" << test_msgs::kHelloName << "\": \"" << msg << "\"}\n";
+    } else {
+      out << test_msgs::kHelloName << " = " << msg << "\n";
+    }
+  }
+  paths.push_back(dir + "simple_tr8n_catalog_source_test_missing.txt");
+
+  std::vector<std::string> errors;
+  auto configs = simple_tr8n::parseCatalogFiles(paths, errors, 3);
+  ASSERT_THAT(configs.size(), Eq(paths.size()));
+  ASSERT_THAT(errors.size(), Eq(paths.size()));
+
+  for (std::size_t i = 0; i < 6; ++i) {
+    ASSERT_THAT(configs[i], NotNull()) << errors[i];
+    EXPECT_THAT(errors[i], Eq(""));
+    EXPECT_TRUE(configs[i]->frozen());
+    const simple_tr8n::SimpleTranslator<char> translator{std::move(configs[i])};
+    EXPECT_THAT(
+        translator.translate(test_msgs::kHelloName, {{"personName", "Amy"}}),
+        Eq("hello " + std::to_string(i) + ", Amy!"));
+  }
+  EXPECT_THAT(configs[6], IsNull());
+  EXPECT_THAT(errors[6], Eq(paths[6] + ": can't read source file"));
+}
+
+
+namespace {
+
+// Describes an issue found by verifyCatalogs(), for matching.
+std::string describe(const simple_tr8n::CatalogIssue<char>& issue) {
+  return std::to_string(issue.locale) + " " + std::to_string(static_cast<int>(issue.kind)) + " "
+         + issue.msgType + " " + issue.argKey;
+}
+
+std::string describe(
+    std::size_t locale, simple_tr8n::CatalogIssueKind kind, const std::string& msgType,
+    const std::string& argKey = "") {
+  return describe(simple_tr8n::CatalogIssue<char>{locale, kind, msgType, argKey});
+}
+
+}  // namespace
+
+TEST(CatalogValidatorTest, ShouldVerifyMatchingCatalogs) {
+  simple_tr8n::MsgConfigs<char> en;
+  addTestMsgs(en);
+  en.freeze();
+
+  auto es = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  es->add(test_msgs::kNoArgs, "Un mensaje simple sin argumentos")
+      .add(test_msgs::kHelloName, "hola, %{personName}!")
+      .add(
+          test_msgs::kFishCount,
+          {
+              {0, "%{personName}, no tienes peces"},
+              {simple_tr8n::PluralCategory::kOne, "%{personName}, tienes un pez"},
+              {simple_tr8n::PluralCategory::kOther, "%{personName}, tienes %{fishCount} peces"},
+          })
+      .add(test_msgs::kSum, "%{a} + %{b}");
+  es->freeze();
+
+  EXPECT_THAT(simple_tr8n::verifyCatalogs(en, {&en, es.get()}, 2), ElementsAre());
+  EXPECT_TRUE(en.verified());
+  EXPECT_TRUE(es->verified());
+
+  // Verified translators render the same translations.
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(es)};
+  EXPECT_THAT(translator.translate(test_msgs::kNoArgs), Eq("Un mensaje simple sin argumentos"));
+  EXPECT_THAT(
+      translator.translatePlural(test_msgs::kFishCount, 0, {{"personName", "Ana"}}),
+      Eq("Ana, no tienes peces"));
+  EXPECT_THAT(
+      translator.translatePlural(
+          test_msgs::kFishCount, 7, {{"personName", "Ana"}, {"fishCount", "7"}}),
+      Eq("Ana, tienes 7 peces"));
+  EXPECT_THAT(translator.translate(test_msgs::kSum, "1", "2"), Eq("1 + 2"));
+
+  // Errors are still reported.
+  const auto result = translator.tryTranslate("test.missing");
+  EXPECT_THAT(result.error(), Eq(simple_tr8n::TransError::kMissingMsgType));
+
+  const auto missingArg = translator.tryTranslate(test_msgs::kSum.msgType(), {{"a", "1"}});
+  EXPECT_THAT(missingArg.error(), Eq(simple_tr8n::TransError::kMissingArg));
+  EXPECT_THAT(missingArg.argKey(), Eq("b"));
+  EXPECT_THAT(
+      translator.tryTranslate(test_msgs::kFishCount, {{"personName", "Ana"}}).error(),
+      Eq(simple_tr8n::TransError::kInvalidArgs));
+  EXPECT_THAT(
+      translator.tryTranslatePlural(test_msgs::kNoArgs, 1, {}).error(),
+      Eq(simple_tr8n::TransError::kInvalidArgs));
+}
+
+TEST(CatalogValidatorTest, ShouldReportIssues) {
+  using simple_tr8n::CatalogIssueKind;
+  using simple_tr8n::PluralCategory;
+
+  simple_tr8n::MsgConfigs<char> en;
+  addTestMsgs(en);
+  en.freeze();
+
+  simple_tr8n::MsgConfigs<char> es;
+  es.add(test_msgs::kHelloName, {{0, "hola, %{personName}!"}})
+      .add(
+          test_msgs::kFishCount,
+          {
+              // No case for 0, and %{count} instead of %{fishCount}.
+              {1, "%{personName}, tienes un pez"},
+              {2, "%{personName}, tienes %{count} peces"},
+          })
+      .add(test_msgs::kSum, "%{a} + ...")
+      .add("test.extra", "Extra");
+  es.freeze();
+
+  simple_tr8n::MsgConfigs<char> fr;
+  addTestMsgs(fr);
+  fr.freeze();
+
+  simple_tr8n::MsgConfigs<char> de;
+  de.add(test_msgs::kNoArgs, "Eine einfache Nachricht")
+      .add(test_msgs::kHelloName, "hallo, %{personName}!")
+      .add(
+          test_msgs::kFishCount,
+          {
+              // No kOther case for counts in other categories to fall back to.
+              {0, "%{personName}, du hast keine Fische"},
+              {PluralCategory::kOne, "%{personName}, du hast einen Fisch"},
+              {PluralCategory::kMany, "%{personName}, du hast %{fishCount} Fische"},
+          })
+      .add(test_msgs::kSum, "%{a} + %{b}");
+  de.freeze();
+
+  std::vector<std::string> issues;
+  for (const auto& issue : simple_tr8n::verifyCatalogs(en, {&es, &fr, &de})) {
+    issues.push_back(describe(issue));
+  }
+  EXPECT_THAT(
+      issues, UnorderedElementsAre(
+                  describe(0, CatalogIssueKind::kExtraMsgType, "test.extra"),
+                  describe(0, CatalogIssueKind::kMissingMsgType, test_msgs::kNoArgs),
+                  describe(0, CatalogIssueKind::kPluralMismatch, test_msgs::kHelloName),
+                  describe(0, CatalogIssueKind::kPluralGap, test_msgs::kFishCount),
+                  describe(0, CatalogIssueKind::kMissingArg, test_msgs::kFishCount, "fishCount"),
+                  describe(0, CatalogIssueKind::kExtraArg, test_msgs::kFishCount, "count"),
+                  describe(0, CatalogIssueKind::kMissingArg, "test.sum", "b"),
+                  describe(2, CatalogIssueKind::kPluralGap, test_msgs::kFishCount)));
+
+  EXPECT_FALSE(es.verified());
+  EXPECT_TRUE(fr.verified());
+  EXPECT_FALSE(de.verified());
+  EXPECT_FALSE(en.verified());  // Only the locales are verified.
+}
+
+TEST(CatalogValidatorTest, ShouldVerifyHashOnlyCatalogs) {
+  simple_tr8n::MsgConfigs<char> en;
+  addTestMsgs(en);
+  en.freeze();
+
+  simple_tr8n::MsgConfigs<char> es;
+  es.setKeyStorage(simple_tr8n::KeyStorage::kHashOnly);
+  addTestMsgs(es);
+  es.freeze();
+
+  simple_tr8n::MsgConfigs<char> fr;
+  fr.setKeyStorage(simple_tr8n::KeyStorage::kHashOnly);
+  addTestMsgs(fr);
+  fr.add("test.extra", "Extra");
+  fr.freeze();
+
+  std::vector<std::string> issues;
+  for (const auto& issue : simple_tr8n::verifyCatalogs(en, {&es, &fr})) {
+    issues.push_back(describe(issue));
+  }
+  // Extra message types are found, but can't be named.
+  EXPECT_THAT(issues, ElementsAre(describe(1, simple_tr8n::CatalogIssueKind::kExtraMsgType, "")));
+  EXPECT_TRUE(es.verified());
+  EXPECT_FALSE(fr.verified());
+}
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_CATALOG_VALIDATOR_HPP
+#define SIMPLE_TR8N_CATALOG_VALIDATOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/msg_template.hpp"
+#include "simple_tr8n/plural_rules.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+#include "simple_tr8n/string_view.hpp"
+
+namespace simple_tr8n {
+
+/** Kind of inconsistency found by verifyCatalogs(). */
+enum class CatalogIssueKind : std::uint8_t {
+  kMissingMsgType,  // Message type in the reference catalog, but not in the locale's.
+  kExtraMsgType,    // Message type in the locale's catalog, but not in the reference
+                    // (empty if the locale's catalog only stores hashes).
+  kPluralMismatch,  // Message is plural in one catalog but not in the other.
+  kPluralGap,       // Some plural count >= 0 selects no case.
+  kMissingArg,      // Reference message uses an argument key the locale's doesn't.
+  kExtraArg,        // Locale's message uses an argument key the reference doesn't.
+};
+
+/** Inconsistency found by verifyCatalogs() in one message of one locale. */
+template<typename CharT>
+struct CatalogIssue {
+  std::size_t locale;  // Index of the locale's catalog.
+  CatalogIssueKind kind;
+  std::basic_string<CharT> msgType;
+  std::basic_string<CharT> argKey;  // Only for kMissingArg and kExtraArg.
+};
+
+namespace internal {
+
+/** Returns the sorted, distinct argument keys used by any case of config. */
+template<typename CharT>
+std::vector<basic_string_view<CharT>> msgArgKeys(const MsgConfig<CharT>& config) {
+  std::vector<basic_string_view<CharT>> argKeys;
+  for (const auto& msgCase : config.cases()) {
+    for (const auto& segment : msgCase.segments()) {
+      if (segment.isArg()) {
+        argKeys.push_back(segmentText<CharT>(msgCase.msg(), segment));
+      }
+    }
+  }
+  std::sort(argKeys.begin(), argKeys.end());
+  argKeys.erase(std::unique(argKeys.begin(), argKeys.end()), argKeys.end());
+  return argKeys;
+}
+
+/**
+ * Returns true if every plural count >= 0 selects a case of the plural config:
+ * it has a kOther case if configured by category (which all other categories
+ * fall back to), else a case for count 0.
+ */
+template<typename CharT>
+bool coversAllCounts(const MsgConfig<CharT>& config) {
+  bool hasZero = false;
+  for (const auto& msgCase : config.cases()) {
+    if (msgCase.hasCategory() && msgCase.category() == PluralCategory::kOther) {
+      return true;
+    }
+    hasZero = hasZero || (!msgCase.hasCategory() && msgCase.count() <= 0);
+  }
+  return !config.hasCategoryCases() && hasZero;
+}
+
+/** Appends the issues of locale (at index localeIndex) against reference to issues. */
+template<typename CharT>
+void findCatalogIssues(
+    const MsgConfigs<CharT>& reference, const MsgConfigs<CharT>& locale,
+    std::size_t localeIndex, std::vector<CatalogIssue<CharT>>& issues) {
+  const auto report = [&](CatalogIssueKind kind, basic_string_view<CharT> msgType,
+                          basic_string_view<CharT> argKey) {
+    issues.push_back(CatalogIssue<CharT>{
+        localeIndex, kind, std::basic_string<CharT>{msgType}, std::basic_string<CharT>{argKey}});
+  };
+
+  const bool localeHasKeys = (locale.keyStorage() != KeyStorage::kHashOnly);
+  if (localeHasKeys) {
+    for (std::uint32_t i = 0; i < locale.size(); ++i) {
+      if (!reference.has(locale.msgTypeAt(i))) {
+        report(CatalogIssueKind::kExtraMsgType, locale.msgTypeAt(i), {});
+      }
+    }
+  }
+
+  std::size_t numFound = 0;
+  for (std::uint32_t i = 0; i < reference.size(); ++i) {
+    const basic_string_view<CharT> msgType = reference.msgTypeAt(i);
+    const MsgConfig<CharT>& expected = reference.at(i);
+    const MsgConfig<CharT>* const config = locale.find(msgType);
+    if (config == nullptr) {
+      report(CatalogIssueKind::kMissingMsgType, msgType, {});
+      continue;
+    }
+    ++numFound;
+
+    if (config->hasPluralCases() != expected.hasPluralCases()) {
+      report(CatalogIssueKind::kPluralMismatch, msgType, {});
+    } else if (config->hasPluralCases() && !coversAllCounts(*config)) {
+      report(CatalogIssueKind::kPluralGap, msgType, {});
+    }
+
+    const auto expectedArgKeys = msgArgKeys(expected);
+    const auto argKeys = msgArgKeys(*config);
+    for (const auto& argKey : expectedArgKeys) {
+      if (!std::binary_search(argKeys.begin(), argKeys.end(), argKey)) {
+        report(CatalogIssueKind::kMissingArg, msgType, argKey);
+      }
+    }
+    for (const auto& argKey : argKeys) {
+      if (!std::binary_search(expectedArgKeys.begin(), expectedArgKeys.end(), argKey)) {
+        report(CatalogIssueKind::kExtraArg, msgType, argKey);
+      }
+    }
+  }
+
+  if (!localeHasKeys && (numFound < locale.size())) {
+    // Extra message types can be detected, but not named.
+    report(CatalogIssueKind::kExtraMsgType, {}, {});
+  }
+}
+
+}  // namespace internal
+
+/**
+ * Checks the frozen catalogs of each locale against the frozen reference
+ * catalog (e.g. the source language's, which may also be one of the locales,
+ * and must keep its message types; see MsgConfigs::setKeyStorage()), in
+ * parallel on up to numThreads threads including the calling one (0 for one
+ * per hardware thread). Each locale must have the same message types as the
+ * reference, each message must be plural exactly if the reference's is,
+ * every plural count from 0 up must select a case, and the argument keys used
+ * by all cases of each message must match the reference's.
+ *
+ * Returns all issues found, ordered by locale. Each locale without issues is
+ * marked verified (see MsgConfigs::markVerified()), so SimpleTranslators
+ * built from it render in a single pass without measuring first. They still
+ * report errors, but append-only sinks (without resize()) keep partial output
+ * on a missing argument.
+ */
+template<typename CharT>
+std::vector<CatalogIssue<CharT>> verifyCatalogs(
+    const MsgConfigs<CharT>& reference, const std::vector<MsgConfigs<CharT>*>& locales,
+    unsigned numThreads = 0) {
+  Expects(reference.frozen());
+  Expects(reference.keyStorage() != KeyStorage::kHashOnly);
+  std::vector<std::vector<CatalogIssue<CharT>>> localeIssues(locales.size());
+
+  std::atomic<std::size_t> next{0};
+  const auto work = [&]() {
+    for (std::size_t i = next++; i < locales.size(); i = next++) {
+      Expects(locales[i] != nullptr && locales[i]->frozen());
+      internal::findCatalogIssues(reference, *locales[i], i, localeIssues[i]);
+    }
+  };
+
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, locales.size()));
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < numThreads; ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<CatalogIssue<CharT>> issues;
+  for (std::size_t i = 0; i < locales.size(); ++i) {
+    if (localeIssues[i].empty()) {
+      locales[i]->markVerified();
+    }
+    issues.insert(issues.end(), localeIssues[i].begin(), localeIssues[i].end());
+  }
+  return issues;
+}
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_CATALOG_VALIDATOR_HPP
@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_CHAR_SCAN_HPP
+#define SIMPLE_TR8N_CHAR_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// SIMD scanning is opt-in (SIMPLE_TR8N_ENABLE_SIMD, on by default in CMake
+// builds) and only implemented for x86. SSE2 is always available on x86-64;
+// AVX2 is compiled with per-function target attributes (GCC and Clang only)
+// and used only if the CPU supports it at runtime.
+#if defined(SIMPLE_TR8N_ENABLE_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define SIMPLE_TR8N_SIMD_SSE2
+  #include <emmintrin.h>
+  #if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+  #endif
+
+  #if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define SIMPLE_TR8N_SIMD_AVX2
+    #include <immintrin.h>
+  #endif
+#endif
+
+namespace simple_tr8n {
+namespace internal {
+
+/** Instruction sets that findFirstOf() can use, from least to most preferred. */
+enum class ScanLevel { kScalar, kSse2, kAvx2 };
+
+/** Returns the best ScanLevel this build supports on the current CPU. */
+inline ScanLevel detectScanLevel() {
+#if defined(SIMPLE_TR8N_SIMD_AVX2)
+  if (__builtin_cpu_supports("avx2")) {
+    return ScanLevel::kAvx2;
+  }
+#endif
+#if defined(SIMPLE_TR8N_SIMD_SSE2)
+  return ScanLevel::kSse2;
+#else
+  return ScanLevel::kScalar;
+#endif
+}
+
+/** Cached detectScanLevel() result. */
+inline ScanLevel bestScanLevel() {
+  static const ScanLevel level = detectScanLevel();
+  return level;
+}
+
+/** Returns the first position in [pos, size) holding a, b or c, or size if none does. */
+template<typename CharT>
+std::size_t findFirstOfScalar(
+    const CharT* data, std::size_t pos, std::size_t size, CharT a, CharT b, CharT c) {
+  for (; pos < size; ++pos) {
+    const CharT ch = data[pos];
+    if (ch == a || ch == b || ch == c) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+#if defined(SIMPLE_TR8N_SIMD_SSE2)
+
+/** Index of the lowest set bit of a non-zero mask. */
+inline unsigned lowestBit(std::uint32_t mask) {
+  #if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+  #else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+  #endif
+}
+
+/** Per-character-size SSE2 operations (only 1, 2 and 4 byte characters). */
+template<std::size_t CharSize>
+struct Sse2Ops;
+
+template<>
+struct Sse2Ops<1> {
+  static __m128i broadcast(std::uint32_t ch) { return _mm_set1_epi8(static_cast<char>(ch)); }
+  static __m128i equal(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+};
+
+template<>
+struct Sse2Ops<2> {
+  static __m128i broadcast(std::uint32_t ch) { return _mm_set1_epi16(static_cast<short>(ch)); }
+  static __m128i equal(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+template<>
+struct Sse2Ops<4> {
+  static __m128i broadcast(std::uint32_t ch) { return _mm_set1_epi32(static_cast<int>(ch)); }
+  static __m128i equal(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+/** Same as findFirstOfScalar(), 16 bytes at a time. */
+template<typename CharT>
+std::size_t findFirstOfSse2(
+    const CharT* data, std::size_t pos, std::size_t size, CharT a, CharT b, CharT c) {
+  using Ops = Sse2Ops<sizeof(CharT)>;
+  constexpr std::size_t kCharsPerBlock = 16 / sizeof(CharT);
+
+  const __m128i va = Ops::broadcast(static_cast<std::uint32_t>(a));
+  const __m128i vb = Ops::broadcast(static_cast<std::uint32_t>(b));
+  const __m128i vc = Ops::broadcast(static_cast<std::uint32_t>(c));
+  for (; pos + kCharsPerBlock <= size; pos += kCharsPerBlock) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const __m128i matches = _mm_or_si128(
+        _mm_or_si128(Ops::equal(block, va), Ops::equal(block, vb)), Ops::equal(block, vc));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+    if (mask != 0) {
+      return pos + lowestBit(mask) / sizeof(CharT);
+    }
+  }
+  return findFirstOfScalar(data, pos, size, a, b, c);
+}
+
+#endif  // SIMPLE_TR8N_SIMD_SSE2
+
+#if defined(SIMPLE_TR8N_SIMD_AVX2)
+
+/** Per-character-size AVX2 operations (only 1, 2 and 4 byte characters). */
+template<std::size_t CharSize>
+struct Avx2Ops;
+
+template<>
+struct Avx2Ops<1> {
+  __attribute__((target("avx2"))) static __m256i broadcast(std::uint32_t ch) {
+    return _mm256_set1_epi8(static_cast<char>(ch));
+  }
+  __attribute__((target("avx2"))) static __m256i equal(__m256i a, __m256i b) {
+    return _mm256_cmpeq_epi8(a, b);
+  }
+};
+
+template<>
+struct Avx2Ops<2> {
+  __attribute__((target("avx2"))) static __m256i broadcast(std::uint32_t ch) {
+    return _mm256_set1_epi16(static_cast<short>(ch));
+  }
+  __attribute__((target("avx2"))) static __m256i equal(__m256i a, __m256i b) {
+    return _mm256_cmpeq_epi16(a, b);
+  }
+};
+
+template<>
+struct Avx2Ops<4> {
+  __attribute__((target("avx2"))) static __m256i broadcast(std::uint32_t ch) {
+    return _mm256_set1_epi32(static_cast<int>(ch));
+  }
+  __attribute__((target("avx2"))) static __m256i equal(__m256i a, __m256i b) {
+    return _mm256_cmpeq_epi32(a, b);
+  }
+};
+
+/** Same as findFirstOfScalar(), 32 bytes at a time. Requires AVX2 support. */
+template<typename CharT>
+__attribute__((target("avx2"))) std::size_t findFirstOfAvx2(
+    const CharT* data, std::size_t pos, std::size_t size, CharT a, CharT b, CharT c) {
+  using Ops = Avx2Ops<sizeof(CharT)>;
+  constexpr std::size_t kCharsPerBlock = 32 / sizeof(CharT);
+
+  const __m256i va = Ops::broadcast(static_cast<std::uint32_t>(a));
+  const __m256i vb = Ops::broadcast(static_cast<std::uint32_t>(b));
+  const __m256i vc = Ops::broadcast(static_cast<std::uint32_t>(c));
+  for (; pos + kCharsPerBlock <= size; pos += kCharsPerBlock) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const __m256i matches = _mm256_or_si256(
+        _mm256_or_si256(Ops::equal(block, va), Ops::equal(block, vb)), Ops::equal(block, vc));
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+    if (mask != 0) {
+      return pos + lowestBit(mask) / sizeof(CharT);
+    }
+  }
+  return findFirstOfSse2(data, pos, size, a, b, c);
+}
+
+#endif  // SIMPLE_TR8N_SIMD_AVX2
+
+template<typename CharT>
+std::size_t findFirstOf(
+    ScanLevel level, const CharT* data, std::size_t pos, std::size_t size, CharT a, CharT b,
+    CharT c, std::true_type /*hasSimd*/) {
+  switch (level) {
+#if defined(SIMPLE_TR8N_SIMD_AVX2)
+    case ScanLevel::kAvx2:
+      return findFirstOfAvx2(data, pos, size, a, b, c);
+#endif
+#if defined(SIMPLE_TR8N_SIMD_SSE2)
+    case ScanLevel::kSse2:
+      return findFirstOfSse2(data, pos, size, a, b, c);
+#endif
+    default:
+      return findFirstOfScalar(data, pos, size, a, b, c);
+  }
+}
+
+template<typename CharT>
+std::size_t findFirstOf(
+    ScanLevel, const CharT* data, std::size_t pos, std::size_t size, CharT a, CharT b, CharT c,
+    std::false_type /*hasSimd*/) {
+  return findFirstOfScalar(data, pos, size, a, b, c);
+}
+
+/**
+ * Returns the first position in [pos, size) of data holding any of the
+ * characters a, b or c (pass the same character more than once to find fewer),
+ * or size if there is none. Uses the given instruction set, which must be no
+ * better than bestScanLevel(), for character types of 1, 2 or 4 bytes.
+ */
+template<typename CharT>
+std::size_t findFirstOf(
+    ScanLevel level, const CharT* data, std::size_t pos, std::size_t size, CharT a, CharT b,
+    CharT c) {
+  using HasSimd = std::integral_constant<
+      bool, (sizeof(CharT) == 1) || (sizeof(CharT) == 2) || (sizeof(CharT) == 4)>;
+  return findFirstOf(level, data, pos, size, a, b, c, HasSimd{});
+}
+
+}  // namespace internal
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_CHAR_SCAN_HPP
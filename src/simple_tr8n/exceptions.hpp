@@ -94,6 +94,43 @@ inline InvalidArgsException<char>::InvalidArgsException(basic_string_view<char>
   what_.append(std::basic_string<char>{msgType});
 }
 
+/** Exception thrown if a binary catalog file can't be written or loaded. */
+struct CatalogException : public std::exception {
+public:
+  CatalogException(const std::string& path, const char* problem);
+  ~CatalogException() override = default;
+  const char* what() const noexcept override { return what_.c_str(); }
+
+private:
+  std::string what_;
+};
+
+inline CatalogException::CatalogException(const std::string& path, const char* problem)
+    : what_("simple_tr8n::CatalogException: ") {
+  what_.append(path);
+  what_.append(": ");
+  what_.append(problem);
+}
+
+/** Exception thrown if a plural rule expression is invalid. */
+struct InvalidPluralRuleException : public std::exception {
+public:
+  InvalidPluralRuleException(const std::string& rule, const char* problem);
+  ~InvalidPluralRuleException() override = default;
+  const char* what() const noexcept override { return what_.c_str(); }
+
+private:
+  std::string what_;
+};
+
+inline InvalidPluralRuleException::InvalidPluralRuleException(
+    const std::string& rule, const char* problem)
+    : what_("simple_tr8n::InvalidPluralRuleException: ") {
+  what_.append(problem);
+  what_.append(": ");
+  what_.append(rule);
+}
+
 }  // namespace simple_tr8n
 
 #endif  // SIMPLE_TR8N_EXCEPTIONS_HPP
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_LOCALE_REGISTRY_HPP
+#define SIMPLE_TR8N_LOCALE_REGISTRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace simple_tr8n {
+
+/**
+ * Set of locales whose translators are only built when first requested, from
+ * a loader function registered for each locale (e.g. one that calls
+ * loadCatalog()). Locales that are never requested cost nothing but their
+ * loader.
+ *
+ * One locale is the default, which serves requests for unregistered locales,
+ * for locales whose loader returned nullptr, and (with getOrDefault()) for
+ * locales still loading in the background.
+ *
+ * All locales must be added before any translators are requested. After that,
+ * all member functions are thread-safe, and each loader runs at most once.
+ */
+template<typename CharT>
+class LocaleRegistry {
+public:
+  using Loader = std::function<std::unique_ptr<MsgConfigs<CharT>>()>;
+  using TranslatorPtr = std::shared_ptr<const SimpleTranslator<CharT>>;
+
+  explicit LocaleRegistry(std::string defaultLocale) : defaultLocale_{std::move(defaultLocale)} {}
+
+  /**
+   * Waits for any background loads still running (even if callers still hold
+   * futures from loadAsync(), which don't wait when destroyed themselves).
+   */
+  ~LocaleRegistry() {
+    for (const auto& itr : locales_) {
+      const std::shared_future<void>& ready = itr.second->ready;
+      // Note: Deferred loads only run in get(), so there is nothing to wait for.
+      if (ready.valid()
+          && ready.wait_for(std::chrono::seconds{0}) != std::future_status::deferred) {
+        ready.wait();
+      }
+    }
+  }
+
+  LocaleRegistry(const LocaleRegistry&) = delete;
+  LocaleRegistry& operator=(const LocaleRegistry&) = delete;
+
+  LocaleRegistry(LocaleRegistry&&) = delete;
+  LocaleRegistry& operator=(LocaleRegistry&&) = delete;
+
+  /** Registers the loader for a locale, which must not be registered yet. */
+  LocaleRegistry& add(const std::string& locale, Loader loader) {
+    Expects(!started_);
+    Expects(loader != nullptr);
+    const bool added =
+        locales_.emplace(locale, std::make_unique<Locale>(std::move(loader))).second;
+    Expects(added);
+    return *this;
+  }
+
+  const std::string& defaultLocale() const { return defaultLocale_; }
+
+  /**
+   * Returns the translator for the given locale, loading it on this thread if
+   * it hasn't been requested before (or waiting for it, if it is loading on
+   * another thread). Falls back to the default locale if the locale isn't
+   * registered or fails to load. Returns nullptr only if the default locale
+   * can't be loaded either.
+   *
+   * If exceptions are enabled, exceptions thrown by the loader are rethrown
+   * to every caller requesting its locale.
+   */
+  TranslatorPtr get(const std::string& locale) {
+    markStarted();
+    Locale* const entry = find(locale);
+    if (entry == nullptr) {
+      return (locale != defaultLocale_) ? get(defaultLocale_) : nullptr;
+    }
+
+    startLoad(*entry, std::launch::deferred).get();
+    const TranslatorPtr translator = std::atomic_load(&entry->translator);
+    if (translator == nullptr && locale != defaultLocale_) {
+      return get(defaultLocale_);
+    }
+    return translator;
+  }
+
+  /**
+   * Same as get(), but never waits for a locale other than the default one:
+   * if the locale isn't loaded yet, starts loading it in the background (see
+   * loadAsync()) and returns the default locale's translator for now.
+   */
+  TranslatorPtr getOrDefault(const std::string& locale) {
+    markStarted();
+    Locale* const entry = find(locale);
+    if (entry != nullptr && locale != defaultLocale_) {
+      const std::shared_future<void>& ready = startLoad(*entry, std::launch::async);
+      if (ready.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+        return get(defaultLocale_);
+      }
+    }
+    return get(locale);
+  }
+
+  /**
+   * Starts loading the given locale on a background thread, unless it was
+   * already requested. Returns a future that becomes ready once the locale's
+   * translator is available from get() without waiting. (For unregistered
+   * locales, returns an already ready future.)
+   */
+  std::shared_future<void> loadAsync(const std::string& locale) {
+    markStarted();
+    Locale* const entry = find(locale);
+    if (entry == nullptr) {
+      std::promise<void> ready;
+      ready.set_value();
+      return ready.get_future().share();
+    }
+    return startLoad(*entry, std::launch::async);
+  }
+
+  /** Returns true if the given locale has finished loading successfully. */
+  bool loaded(const std::string& locale) const {
+    const auto itr = locales_.find(locale);
+    return (itr != locales_.end()) && (std::atomic_load(&itr->second->translator) != nullptr);
+  }
+
+private:
+  struct Locale {
+    explicit Locale(Loader loader) : loader{std::move(loader)} {}
+
+    Loader loader;
+    std::once_flag loadStarted;
+    TranslatorPtr translator;  // Note: Only accessed with std::atomic_load/store.
+
+    // Set (once) under loadStarted. Background loads write the others, so
+    // ~LocaleRegistry() waits for them.
+    std::shared_future<void> ready;
+  };
+
+  void markStarted() {
+    if (!started_.load(std::memory_order_relaxed)) {
+      started_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  Locale* find(const std::string& locale) const {
+    const auto itr = locales_.find(locale);
+    return (itr != locales_.end()) ? itr->second.get() : nullptr;
+  }
+
+  /**
+   * Starts loading the locale with the given launch policy, unless already
+   * started. Returns the future for the first load started.
+   */
+  static const std::shared_future<void>& startLoad(Locale& entry, std::launch policy) {
+    std::call_once(entry.loadStarted, [&entry, policy]() {
+      entry.ready = std::async(policy, [&entry]() { load(entry); }).share();
+    });
+    return entry.ready;
+  }
+
+  static void load(Locale& entry) {
+    auto configs = entry.loader();
+    if (configs != nullptr) {
+      std::atomic_store(
+          &entry.translator, std::make_shared<const SimpleTranslator<CharT>>(std::move(configs)));
+    }
+  }
+
+  std::string defaultLocale_;
+  std::map<std::string, std::unique_ptr<Locale>, std::less<>> locales_;
+  std::atomic<bool> started_{false};
+};
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_LOCALE_REGISTRY_HPP
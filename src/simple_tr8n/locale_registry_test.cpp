@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simple_tr8n/locale_registry.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace test_msgs {
+
+constexpr char kHello[] = "test.hello";
+
+}  // namespace test_msgs
+
+namespace {
+
+std::unique_ptr<simple_tr8n::MsgConfigs<char>> helloConfigs(const char* hello) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kHello, hello);
+  return configs;
+}
+
+}  // namespace
+
+using ::testing::Eq;
+using ::testing::IsNull;
+using ::testing::NotNull;
+
+TEST(LocaleRegistryTest, ShouldLoadLocalesOnFirstRequest) {
+  std::atomic<int> numEsLoads{0};
+  simple_tr8n::LocaleRegistry<char> registry{"en"};
+  registry.add("en", []() { return helloConfigs("hello"); })
+      .add("es", [&numEsLoads]() {
+        ++numEsLoads;
+        return helloConfigs("hola");
+      });
+
+  EXPECT_FALSE(registry.loaded("es"));
+  EXPECT_THAT(numEsLoads.load(), Eq(0));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&registry]() {
+      EXPECT_THAT(registry.get("es")->translate(test_msgs::kHello), Eq("hola"));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(registry.loaded("es"));
+  EXPECT_FALSE(registry.loaded("en"));
+  EXPECT_THAT(numEsLoads.load(), Eq(1));
+}
+
+TEST(LocaleRegistryTest, ShouldFallBackToDefaultLocale) {
+  simple_tr8n::LocaleRegistry<char> registry{"en"};
+  registry.add("en", []() { return helloConfigs("hello"); })
+      .add("broken", []() { return std::unique_ptr<simple_tr8n::MsgConfigs<char>>{}; });
+
+  EXPECT_THAT(registry.get("fr")->translate(test_msgs::kHello), Eq("hello"));
+  EXPECT_THAT(registry.get("broken")->translate(test_msgs::kHello), Eq("hello"));
+  EXPECT_FALSE(registry.loaded("broken"));
+
+  simple_tr8n::LocaleRegistry<char> emptyRegistry{"en"};
+  EXPECT_THAT(emptyRegistry.get("en"), IsNull());
+}
+
+TEST(LocaleRegistryTest, ShouldServeDefaultWhileLoadingInBackground) {
+  std::promise<void> allowLoad;
+  std::shared_future<void> loadAllowed = allowLoad.get_future().share();
+
+  simple_tr8n::LocaleRegistry<char> registry{"en"};
+  registry.add("en", []() { return helloConfigs("hello"); })
+      .add("es", [loadAllowed]() {
+        loadAllowed.wait();
+        return helloConfigs("hola");
+      });
+
+  EXPECT_THAT(registry.getOrDefault("es")->translate(test_msgs::kHello), Eq("hello"));
+  const auto ready = registry.loadAsync("es");
+  EXPECT_THAT(ready.wait_for(std::chrono::milliseconds{10}), Eq(std::future_status::timeout));
+  EXPECT_THAT(registry.getOrDefault("es")->translate(test_msgs::kHello), Eq("hello"));
+
+  allowLoad.set_value();
+  ready.wait();
+  EXPECT_TRUE(registry.loaded("es"));
+  EXPECT_THAT(registry.getOrDefault("es")->translate(test_msgs::kHello), Eq("hola"));
+}
+
+TEST(LocaleRegistryTest, ShouldPreloadInBackground) {
+  simple_tr8n::LocaleRegistry<char> registry{"en"};
+  registry.add("en", []() { return helloConfigs("hello"); });
+
+  registry.loadAsync("en").wait();
+  EXPECT_TRUE(registry.loaded("en"));
+  EXPECT_THAT(registry.get("en"), NotNull());
+
+  // Unregistered locales are always ready.
+  EXPECT_THAT(
+      registry.loadAsync("fr").wait_for(std::chrono::seconds{0}), Eq(std::future_status::ready));
+}
+
+TEST(LocaleRegistryTest, ShouldWaitForBackgroundLoadsWhenDestroyed) {
+  std::promise<void> loadStarted;
+  std::atomic<bool> loadFinished{false};
+
+  auto registry = std::make_unique<simple_tr8n::LocaleRegistry<char>>("en");
+  registry->add("en", []() { return helloConfigs("hello"); })
+      .add("es", [&loadStarted, &loadFinished]() {
+        loadStarted.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        loadFinished = true;
+        return helloConfigs("hola");
+      });
+
+  // Holding a copy of the future doesn't stop the registry from waiting.
+  const auto ready = registry->loadAsync("es");
+  loadStarted.get_future().wait();
+  registry.reset();
+  EXPECT_TRUE(loadFinished.load());
+  EXPECT_THAT(ready.wait_for(std::chrono::seconds{0}), Eq(std::future_status::ready));
+}
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(LocaleRegistryTest, ShouldRethrowLoaderExceptions) {
+  simple_tr8n::LocaleRegistry<char> registry{"en"};
+  registry.add("en", []() -> std::unique_ptr<simple_tr8n::MsgConfigs<char>> {
+    throw std::runtime_error{"can't load"};
+  });
+
+  EXPECT_THROW(registry.get("en"), std::runtime_error);
+  EXPECT_THROW(registry.get("en"), std::runtime_error);
+}
+
+#endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
@@ -0,0 +1,542 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_METRICS_HPP
+#define SIMPLE_TR8N_METRICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/perfect_hash.hpp"
+#include "simple_tr8n/string_view.hpp"
+
+namespace simple_tr8n {
+
+/**
+ * Histogram of sampled render latencies, in power of 2 nanosecond buckets:
+ * bucket 0 counts latencies under 2 ns, and each bucket i > 0 counts
+ * latencies in [2^i, 2^(i + 1)) ns. The last bucket also counts anything
+ * longer.
+ */
+struct LatencyHistogram {
+  static constexpr std::size_t kNumBuckets = 32;  // Last bucket starts at about 2 seconds.
+
+  std::array<std::uint64_t, kNumBuckets> buckets{};
+  std::uint64_t sumNanos = 0;
+
+  /** Returns the bucket counting the given latency. */
+  static std::size_t bucketFor(std::uint64_t nanos) {
+    std::size_t bucket = 0;
+    while ((nanos > 1) && (bucket + 1 < kNumBuckets)) {
+      nanos >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  /** Upper bound (exclusive, in nanoseconds) of latencies in the given bucket. */
+  static std::uint64_t bucketEndNanos(std::size_t bucket) {
+    return std::uint64_t{2} << bucket;
+  }
+
+  /** Total number of samples. */
+  std::uint64_t count() const {
+    std::uint64_t result = 0;
+    for (const std::uint64_t bucketCount : buckets) {
+      result += bucketCount;
+    }
+    return result;
+  }
+
+  /**
+   * Returns an upper bound (in nanoseconds) for the given quantile (from 0 to
+   * 1) of samples, i.e. the end of its bucket. Returns 0 if there are no
+   * samples.
+   */
+  std::uint64_t quantileNanos(double quantile) const {
+    const std::uint64_t total = count();
+    if (total == 0) {
+      return 0;
+    }
+
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(quantile * static_cast<double>(total) + 0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+      seen += buckets[bucket];
+      if (seen >= rank) {
+        return bucketEndNanos(bucket);
+      }
+    }
+    return bucketEndNanos(kNumBuckets - 1);
+  }
+};
+
+/** A message type and how many times it was requested. */
+template<typename CharT>
+struct MsgTypeCount {
+  std::basic_string<CharT> msgType;
+  std::uint64_t count = 0;
+};
+
+/**
+ * Point in time copy of a SimpleTranslator's metrics (see
+ * SimpleTranslator::metrics()), summed over all threads.
+ */
+template<typename CharT>
+struct MetricsSnapshot {
+  /** Configured message types translated at least once, most used first. */
+  std::vector<MsgTypeCount<CharT>> hits;
+
+  /**
+   * Requested message types that aren't configured, most requested first.
+   * Only the first MetricsRecorder::kMaxMissingMsgTypes distinct types (that
+   * fit in a fixed amount of space) are kept per thread, but
+   * numMissingMsgTypes counts every request.
+   */
+  std::vector<MsgTypeCount<CharT>> missingMsgTypes;
+
+  std::uint64_t numHits = 0;
+  std::uint64_t numMissingMsgTypes = 0;
+  std::uint64_t numInvalidArgs = 0;  // Plural mismatches, or no case for a plural count.
+  std::uint64_t numMissingArgs = 0;
+
+  /** Sampled latencies of successful renders (excluding message lookup). */
+  LatencyHistogram latency;
+};
+
+namespace internal {
+
+/** Appends value as a Prometheus label value (quoted, with escapes). */
+inline void appendLabelValue(std::string& out, const std::string& value) {
+  out += '"';
+  for (const char c : value) {
+    if (c == '\n') {
+      out += "\\n";
+      continue;
+    }
+    if ((c == '\\') || (c == '"')) {
+      out += '\\';
+    }
+    out += c;
+  }
+  out += '"';
+}
+
+inline void appendCounter(std::string& out, const char* name, std::uint64_t value) {
+  out += "# TYPE ";
+  out += name;
+  out += " counter\n";
+  out += name;
+  out += ' ';
+  out += std::to_string(value);
+  out += '\n';
+}
+
+inline void appendMsgTypeCounts(
+    std::string& out, const char* name, const std::vector<MsgTypeCount<char>>& counts) {
+  out += "# TYPE ";
+  out += name;
+  out += " counter\n";
+  for (const auto& entry : counts) {
+    out += name;
+    out += "{msg_type=";
+    appendLabelValue(out, entry.msgType);
+    out += "} ";
+    out += std::to_string(entry.count);
+    out += '\n';
+  }
+}
+
+inline void appendSeconds(std::string& out, std::uint64_t nanos) {
+  std::array<char, 32> buffer{};
+  std::snprintf(buffer.data(), buffer.size(), "%.9g", static_cast<double>(nanos) * 1e-9);
+  out += buffer.data();
+}
+
+}  // namespace internal
+
+/**
+ * Exports a snapshot in the Prometheus text exposition format, with metric
+ * names prefixed by simple_tr8n_.
+ */
+inline std::string formatMetrics(const MetricsSnapshot<char>& snapshot) {
+  std::string out;
+  internal::appendMsgTypeCounts(out, "simple_tr8n_msg_hits_total", snapshot.hits);
+  internal::appendMsgTypeCounts(
+      out, "simple_tr8n_missing_msg_type_hits_total", snapshot.missingMsgTypes);
+  internal::appendCounter(out, "simple_tr8n_missing_msg_types_total", snapshot.numMissingMsgTypes);
+  internal::appendCounter(out, "simple_tr8n_invalid_args_total", snapshot.numInvalidArgs);
+  internal::appendCounter(out, "simple_tr8n_missing_args_total", snapshot.numMissingArgs);
+
+  constexpr char kLatency[] = "simple_tr8n_render_latency_seconds";
+  const LatencyHistogram& latency = snapshot.latency;
+  out += "# TYPE ";
+  out += kLatency;
+  out += " histogram\n";
+
+  std::uint64_t cumulative = 0;
+  for (std::size_t bucket = 0; bucket + 1 < LatencyHistogram::kNumBuckets; ++bucket) {
+    cumulative += latency.buckets[bucket];
+    out += kLatency;
+    out += "_bucket{le=\"";
+    internal::appendSeconds(out, LatencyHistogram::bucketEndNanos(bucket));
+    out += "\"} ";
+    out += std::to_string(cumulative);
+    out += '\n';
+  }
+
+  const std::uint64_t count = latency.count();
+  out += kLatency;
+  out += "_bucket{le=\"+Inf\"} ";
+  out += std::to_string(count);
+  out += '\n';
+  out += kLatency;
+  out += "_sum ";
+  internal::appendSeconds(out, latency.sumNanos);
+  out += '\n';
+  out += kLatency;
+  out += "_count ";
+  out += std::to_string(count);
+  out += '\n';
+  return out;
+}
+
+namespace internal {
+
+/**
+ * Counter only ever incremented by one thread, but readable from any: a
+ * relaxed load and store, with no locked read-modify-write instruction.
+ */
+class SingleWriterCounter {
+public:
+  void add(std::uint64_t n) {
+    value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  std::uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<std::uint64_t> value_{0};
+};
+
+/** Missing message type recorded by one thread, in ThreadMetrics::missingMsgTypeChars. */
+struct MissingMsgTypeCount {
+  std::uint64_t hash = 0;  // See hashKey().
+  std::uint32_t offset = 0;
+  std::uint32_t size = 0;
+  std::uint64_t count = 0;
+};
+
+/** Metrics recorded by one thread for one MetricsRecorder. */
+template<typename CharT>
+struct ThreadMetrics {
+  static constexpr std::size_t kMaxMissingMsgTypes = 256;       // Distinct types kept.
+  static constexpr std::size_t kMaxMissingMsgTypeChars = 8192;  // Their total length.
+
+  explicit ThreadMetrics(std::size_t numMsgs)
+      : hits{std::make_unique<SingleWriterCounter[]>(numMsgs)},
+        missingMsgTypeChars{std::make_unique<CharT[]>(kMaxMissingMsgTypeChars)} {}
+
+  // Note: Each ThreadMetrics is allocated separately, so pad both ends to keep
+  // other threads' data off of its cache lines. (Over-aligning ThreadMetrics
+  // instead would need C++17 aligned new.)
+  char frontPadding[64];
+
+  std::unique_ptr<SingleWriterCounter[]> hits;  // By message index.
+  SingleWriterCounter numMissingMsgTypes;
+  SingleWriterCounter numInvalidArgs;
+  SingleWriterCounter numMissingArgs;
+  std::array<SingleWriterCounter, LatencyHistogram::kNumBuckets> latencyBuckets;
+  SingleWriterCounter latencySumNanos;
+  std::uint32_t untilSample = 1;  // Only accessed by the owning thread.
+
+  // Note: Missing message types are kept in space allocated up front, so that
+  // recording them never allocates (see SimpleTranslator::tryTranslate()).
+  std::mutex missingMutex;  // Only locked for missing message types and snapshots.
+  std::array<MissingMsgTypeCount, kMaxMissingMsgTypes> missingMsgTypes;
+  std::size_t numMissingMsgTypesKept = 0;
+  std::unique_ptr<CharT[]> missingMsgTypeChars;
+  std::size_t numMissingMsgTypeChars = 0;
+
+  char padding[64];
+};
+
+/**
+ * Records SimpleTranslator metrics (if SIMPLE_TR8N_ENABLE_METRICS is defined)
+ * into per-thread counters, so that threads translating concurrently never
+ * write to the same cache lines. Each thread finds its counters through a
+ * small thread_local cache, and registers new ones (under a lock) the first
+ * time it records anything. snapshot() sums all threads' counters.
+ */
+template<typename CharT>
+class MetricsRecorder {
+public:
+  static constexpr std::uint32_t kDefaultLatencySampleInterval = 64;
+  static constexpr std::size_t kMaxMissingMsgTypes =  // Distinct types kept per thread.
+      ThreadMetrics<CharT>::kMaxMissingMsgTypes;
+
+  MetricsRecorder() : id_{nextId()} {}
+
+  ~MetricsRecorder() = default;
+
+  MetricsRecorder(const MetricsRecorder&) = delete;
+  MetricsRecorder& operator=(const MetricsRecorder&) = delete;
+
+  MetricsRecorder(MetricsRecorder&&) = delete;
+  MetricsRecorder& operator=(MetricsRecorder&&) = delete;
+
+  /** Sets the number of message indexes. Must be called before recording anything. */
+  void setNumMsgs(std::size_t numMsgs) { numMsgs_ = numMsgs; }
+
+  /** Samples one in every interval renders on each thread (0 disables sampling). */
+  void setLatencySampleInterval(std::uint32_t interval) {
+    latencySampleInterval_.store(interval, std::memory_order_relaxed);
+  }
+
+  void recordHit(std::uint32_t index) {
+    Expects(index < numMsgs_);
+    local().hits[index].add(1);
+  }
+
+  /**
+   * Counts a request for a message type that isn't configured, keeping the
+   * type itself if this thread still has room for it. Never allocates (once
+   * this thread has registered its metrics).
+   */
+  void recordMissingMsgType(basic_string_view<CharT> msgType) {
+    ThreadMetrics<CharT>& metrics = local();
+    metrics.numMissingMsgTypes.add(1);
+
+    const std::uint64_t hash = hashKey<CharT>(msgType, 0);
+    std::lock_guard<std::mutex> lock{metrics.missingMutex};
+    for (std::size_t i = 0; i < metrics.numMissingMsgTypesKept; ++i) {
+      MissingMsgTypeCount& entry = metrics.missingMsgTypes[i];
+      if ((entry.hash == hash) && (missingMsgTypeAt(metrics, entry) == msgType)) {
+        ++entry.count;
+        return;
+      }
+    }
+
+    if ((metrics.numMissingMsgTypesKept < kMaxMissingMsgTypes)
+        && (msgType.size()
+            <= ThreadMetrics<CharT>::kMaxMissingMsgTypeChars - metrics.numMissingMsgTypeChars)) {
+      MissingMsgTypeCount& entry = metrics.missingMsgTypes[metrics.numMissingMsgTypesKept++];
+      entry.hash = hash;
+      entry.offset = gsl::narrow_cast<std::uint32_t>(metrics.numMissingMsgTypeChars);
+      entry.size = gsl::narrow_cast<std::uint32_t>(msgType.size());
+      entry.count = 1;
+      std::copy(
+          msgType.begin(), msgType.end(),
+          metrics.missingMsgTypeChars.get() + metrics.numMissingMsgTypeChars);
+      metrics.numMissingMsgTypeChars += msgType.size();
+    }
+  }
+
+  void recordInvalidArgs() { local().numInvalidArgs.add(1); }
+
+  void recordMissingArg() { local().numMissingArgs.add(1); }
+
+  /**
+   * Returns the start time of a render if this thread should sample its
+   * latency, or 0 if not. Pass the result to endSample() when done.
+   */
+  std::uint64_t startSample() {
+    ThreadMetrics<CharT>& metrics = local();
+    if (metrics.untilSample > 1) {
+      --metrics.untilSample;
+      return 0;
+    }
+
+    const std::uint32_t interval = latencySampleInterval_.load(std::memory_order_relaxed);
+    if (interval == 0) {
+      return 0;
+    }
+    metrics.untilSample = interval;
+    return std::max<std::uint64_t>(nowNanos(), 1);
+  }
+
+  void endSample(std::uint64_t startNanos) {
+    if (startNanos == 0) {
+      return;
+    }
+
+    const std::uint64_t nanos = nowNanos() - startNanos;
+    ThreadMetrics<CharT>& metrics = local();
+    metrics.latencyBuckets[LatencyHistogram::bucketFor(nanos)].add(1);
+    metrics.latencySumNanos.add(nanos);
+  }
+
+  /** Number of threads that have recorded metrics (each registered once). */
+  std::size_t numThreads() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return threads_.size();
+  }
+
+  /**
+   * Sums all threads' metrics, naming message indexes with msgTypeAt (a
+   * function from std::uint32_t index to basic_string_view<CharT>).
+   */
+  template<typename MsgTypeAt>
+  MetricsSnapshot<CharT> snapshot(MsgTypeAt msgTypeAt) const {
+    MetricsSnapshot<CharT> result;
+    std::vector<std::uint64_t> hits(numMsgs_, 0);
+    std::map<std::basic_string<CharT>, std::uint64_t, std::less<>> missingMsgTypes;
+
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      for (const auto& thread : threads_) {
+        const auto& metrics = thread.second;
+        for (std::size_t i = 0; i < numMsgs_; ++i) {
+          hits[i] += metrics->hits[i].load();
+        }
+        result.numMissingMsgTypes += metrics->numMissingMsgTypes.load();
+        result.numInvalidArgs += metrics->numInvalidArgs.load();
+        result.numMissingArgs += metrics->numMissingArgs.load();
+        for (std::size_t bucket = 0; bucket < LatencyHistogram::kNumBuckets; ++bucket) {
+          result.latency.buckets[bucket] += metrics->latencyBuckets[bucket].load();
+        }
+        result.latency.sumNanos += metrics->latencySumNanos.load();
+
+        std::lock_guard<std::mutex> missingLock{metrics->missingMutex};
+        for (std::size_t i = 0; i < metrics->numMissingMsgTypesKept; ++i) {
+          const MissingMsgTypeCount& entry = metrics->missingMsgTypes[i];
+          const basic_string_view<CharT> msgType = missingMsgTypeAt(*metrics, entry);
+          missingMsgTypes[{msgType.data(), msgType.size()}] += entry.count;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < numMsgs_; ++i) {
+      if (hits[i] > 0) {
+        const basic_string_view<CharT> msgType = msgTypeAt(gsl::narrow_cast<std::uint32_t>(i));
+        result.hits.push_back({{msgType.data(), msgType.size()}, hits[i]});
+        result.numHits += hits[i];
+      }
+    }
+    for (auto& entry : missingMsgTypes) {
+      result.missingMsgTypes.push_back({entry.first, entry.second});
+    }
+
+    sortByCount(result.hits);
+    sortByCount(result.missingMsgTypes);
+    return result;
+  }
+
+private:
+  static constexpr std::size_t kNumCachedRecorders = 8;  // Per thread.
+
+  static std::uint64_t nextId() {
+    static std::atomic<std::uint64_t> lastId{0};
+    return lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  static std::uint64_t nowNanos() {
+    return gsl::narrow_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  static basic_string_view<CharT> missingMsgTypeAt(
+      const ThreadMetrics<CharT>& metrics, const MissingMsgTypeCount& entry) {
+    return {metrics.missingMsgTypeChars.get() + entry.offset, entry.size};
+  }
+
+  /** Most counts first, then by message type (for stable output). */
+  static void sortByCount(std::vector<MsgTypeCount<CharT>>& counts) {
+    std::sort(
+        counts.begin(), counts.end(),
+        [](const MsgTypeCount<CharT>& a, const MsgTypeCount<CharT>& b) {
+          return (a.count != b.count) ? (a.count > b.count) : (a.msgType < b.msgType);
+        });
+  }
+
+  /**
+   * Returns this thread's metrics, registering them on its first call. A
+   * small per-thread cache finds them without locking; threads using more
+   * recorders than it holds look them up again under the lock.
+   */
+  ThreadMetrics<CharT>& local() {
+    // Note: Keyed by unique ID rather than address, so entries for destroyed
+    // recorders never match.
+    struct Cache {
+      std::array<std::uint64_t, kNumCachedRecorders> ids;
+      std::array<ThreadMetrics<CharT>*, kNumCachedRecorders> metrics;
+      std::size_t last;  // Most recently used entry.
+      std::size_t next;  // Next entry to replace.
+    };
+    thread_local Cache cache{};  // Note: Trivial, so accessed without any guard.
+
+    if (cache.ids[cache.last] == id_) {
+      return *cache.metrics[cache.last];
+    }
+    for (std::size_t i = 0; i < kNumCachedRecorders; ++i) {
+      if (cache.ids[i] == id_) {
+        cache.last = i;
+        return *cache.metrics[i];
+      }
+    }
+
+    ThreadMetrics<CharT>* result = nullptr;
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto& metrics = threads_[std::this_thread::get_id()];
+      if (metrics == nullptr) {
+        metrics = std::make_unique<ThreadMetrics<CharT>>(numMsgs_);
+      }
+      result = metrics.get();
+    }
+
+    cache.last = cache.next;
+    cache.next = (cache.next + 1) % kNumCachedRecorders;
+    cache.ids[cache.last] = id_;
+    cache.metrics[cache.last] = result;
+    return *result;
+  }
+
+  const std::uint64_t id_;
+  std::size_t numMsgs_ = 0;
+  std::atomic<std::uint32_t> latencySampleInterval_{kDefaultLatencySampleInterval};
+
+  mutable std::mutex mutex_;
+  // Note: A new thread reusing an exited thread's ID also reuses its metrics,
+  // which keeps memory bounded by the number of live threads seen at once.
+  std::map<std::thread::id, std::unique_ptr<ThreadMetrics<CharT>>> threads_;
+};
+
+template<typename CharT>
+constexpr std::uint32_t MetricsRecorder<CharT>::kDefaultLatencySampleInterval;
+
+template<typename CharT>
+constexpr std::size_t ThreadMetrics<CharT>::kMaxMissingMsgTypes;
+
+template<typename CharT>
+constexpr std::size_t ThreadMetrics<CharT>::kMaxMissingMsgTypeChars;
+
+template<typename CharT>
+constexpr std::size_t MetricsRecorder<CharT>::kMaxMissingMsgTypes;
+
+template<typename CharT>
+constexpr std::size_t MetricsRecorder<CharT>::kNumCachedRecorders;
+
+}  // namespace internal
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_METRICS_HPP
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Note: Always tests metrics, whether or not the build enables them.
+#ifndef SIMPLE_TR8N_ENABLE_METRICS
+  #define SIMPLE_TR8N_ENABLE_METRICS
+#endif
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simple_tr8n/metrics.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace test_msgs {
+
+constexpr char kNoArgs[] = "test.no_args";
+constexpr char kHelloName[] = "test.hello_name";
+constexpr char kNumFiles[] = "test.num_files";
+constexpr char kUnknown[] = "test.unknown";
+
+}  // namespace test_msgs
+
+namespace {
+
+using simple_tr8n::LatencyHistogram;
+
+std::unique_ptr<simple_tr8n::SimpleTranslator<char>> makeTranslator() {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kNoArgs, "Saved")
+      .add(test_msgs::kHelloName, "hello, %{personName}!")
+      .add(test_msgs::kNumFiles, {{1, "1 file"}, {2, "%{num} files"}});
+  return std::make_unique<simple_tr8n::SimpleTranslator<char>>(std::move(configs));
+}
+
+/** Calls fn, ignoring the translation error it causes (if exceptions are enabled). */
+template<typename Fn>
+void ignoringError(Fn fn) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  EXPECT_ANY_THROW(fn());
+#else
+  fn();
+#endif
+}
+
+}  // namespace
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Field;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::StrEq;
+
+TEST(MetricsTest, ShouldCountHitsAndErrors) {
+  const auto translator = makeTranslator();
+  EXPECT_THAT(translator->metrics().hits, IsEmpty());
+
+  for (int i = 0; i < 3; ++i) {
+    translator->translate(test_msgs::kNoArgs);
+  }
+  translator->translate(translator->resolve(test_msgs::kHelloName), {{"personName", "Amy"}});
+  translator->translatePlural(test_msgs::kNumFiles, 2, {{"num", "2"}});
+  EXPECT_THAT(translator->renderedSize(test_msgs::kNoArgs), Eq(5));
+
+  ignoringError([&] { translator->translate(test_msgs::kUnknown); });
+  ignoringError([&] { translator->translatePlural(test_msgs::kUnknown, 1, {}); });
+  ignoringError([&] { translator->translate(test_msgs::kNumFiles); });
+  ignoringError([&] { translator->translatePlural(test_msgs::kNumFiles, 0, {}); });
+  ignoringError([&] { translator->translate(test_msgs::kHelloName); });
+
+  const auto metrics = translator->metrics();
+  EXPECT_THAT(
+      metrics.hits,
+      ElementsAre(
+          Field(&simple_tr8n::MsgTypeCount<char>::msgType, StrEq(test_msgs::kNoArgs)),
+          Field(&simple_tr8n::MsgTypeCount<char>::msgType, StrEq(test_msgs::kNumFiles)),
+          Field(&simple_tr8n::MsgTypeCount<char>::msgType, StrEq(test_msgs::kHelloName))));
+  EXPECT_THAT(metrics.hits[0].count, Eq(4));
+  EXPECT_THAT(metrics.hits[1].count, Eq(3));
+  EXPECT_THAT(metrics.hits[2].count, Eq(2));
+  EXPECT_THAT(metrics.numHits, Eq(9));
+
+  ASSERT_THAT(metrics.missingMsgTypes.size(), Eq(1));
+  EXPECT_THAT(metrics.missingMsgTypes[0].msgType, StrEq(test_msgs::kUnknown));
+  EXPECT_THAT(metrics.missingMsgTypes[0].count, Eq(2));
+  EXPECT_THAT(metrics.numMissingMsgTypes, Eq(2));
+  EXPECT_THAT(metrics.numInvalidArgs, Eq(2));
+  EXPECT_THAT(metrics.numMissingArgs, Eq(1));
+}
+
+TEST(MetricsTest, ShouldSumThreadCounters) {
+  const auto translator = makeTranslator();
+  const auto otherTranslator = makeTranslator();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        translator->translate(test_msgs::kNoArgs);
+        otherTranslator->translatePlural(test_msgs::kNumFiles, 1, {});
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_THAT(translator->metrics().numHits, Eq(4000));
+  EXPECT_THAT(otherTranslator->metrics().numHits, Eq(4000));
+  EXPECT_THAT(otherTranslator->metrics().hits[0].msgType, StrEq(test_msgs::kNumFiles));
+}
+
+TEST(MetricsTest, ShouldRegisterEachThreadOncePerRecorder) {
+  // More recorders than each thread caches, used round robin.
+  constexpr int kNumRecorders = 12;
+  std::vector<std::unique_ptr<simple_tr8n::internal::MetricsRecorder<char>>> recorders;
+  for (int r = 0; r < kNumRecorders; ++r) {
+    recorders.push_back(std::make_unique<simple_tr8n::internal::MetricsRecorder<char>>());
+    recorders.back()->setNumMsgs(1);
+  }
+
+  const auto recordAll = [&recorders]() {
+    for (int i = 0; i < 100; ++i) {
+      for (const auto& recorder : recorders) {
+        recorder->recordHit(0);
+      }
+    }
+  };
+  const auto msgTypeAt = [](std::uint32_t) { return simple_tr8n::basic_string_view<char>{"a"}; };
+
+  recordAll();
+  for (const auto& recorder : recorders) {
+    EXPECT_THAT(recorder->numThreads(), Eq(1));
+    EXPECT_THAT(recorder->snapshot(msgTypeAt).numHits, Eq(100));
+  }
+
+  std::thread{recordAll}.join();
+  for (const auto& recorder : recorders) {
+    EXPECT_THAT(recorder->numThreads(), Eq(2));
+    EXPECT_THAT(recorder->snapshot(msgTypeAt).numHits, Eq(200));
+  }
+}
+
+TEST(MetricsTest, ShouldKeepMissingMsgTypesThatFit) {
+  using Recorder = simple_tr8n::internal::MetricsRecorder<char>;
+  Recorder recorder;
+  recorder.setNumMsgs(0);
+
+  // Too long for the space kept for missing types, so only counted.
+  const std::string tooLong(
+      simple_tr8n::internal::ThreadMetrics<char>::kMaxMissingMsgTypeChars + 1, 'x');
+  recorder.recordMissingMsgType(tooLong);
+  for (std::size_t i = 0; i <= Recorder::kMaxMissingMsgTypes; ++i) {
+    recorder.recordMissingMsgType("test.missing_" + std::to_string(i));
+  }
+  recorder.recordMissingMsgType("test.missing_0");
+
+  const auto metrics =
+      recorder.snapshot([](std::uint32_t) { return simple_tr8n::basic_string_view<char>{}; });
+  ASSERT_THAT(metrics.missingMsgTypes.size(), Eq(Recorder::kMaxMissingMsgTypes));
+  EXPECT_THAT(metrics.missingMsgTypes[0].msgType, StrEq("test.missing_0"));
+  EXPECT_THAT(metrics.missingMsgTypes[0].count, Eq(2));
+  EXPECT_THAT(metrics.numMissingMsgTypes, Eq(Recorder::kMaxMissingMsgTypes + 3));
+}
+
+TEST(MetricsTest, ShouldSampleRenderLatency) {
+  const auto translator = makeTranslator();
+  for (int i = 0; i < 128; ++i) {
+    translator->translate(test_msgs::kNoArgs);
+  }
+  EXPECT_THAT(translator->metrics().latency.count(), Eq(2));
+
+  translator->setLatencySampleInterval(1);
+  for (int i = 0; i < 10; ++i) {
+    translator->translate(test_msgs::kNoArgs);
+  }
+  EXPECT_THAT(translator->metrics().latency.count(), Eq(12));
+
+  translator->setLatencySampleInterval(0);
+  for (int i = 0; i < 100; ++i) {
+    translator->translate(test_msgs::kNoArgs);
+  }
+  EXPECT_THAT(translator->metrics().latency.count(), Eq(12));
+}
+
+TEST(MetricsTest, ShouldComputeLatencyQuantiles) {
+  EXPECT_THAT(LatencyHistogram::bucketFor(0), Eq(0));
+  EXPECT_THAT(LatencyHistogram::bucketFor(1), Eq(0));
+  EXPECT_THAT(LatencyHistogram::bucketFor(2), Eq(1));
+  EXPECT_THAT(LatencyHistogram::bucketFor(1023), Eq(9));
+  EXPECT_THAT(LatencyHistogram::bucketFor(1024), Eq(10));
+  EXPECT_THAT(LatencyHistogram::bucketFor(UINT64_MAX), Eq(31));
+
+  LatencyHistogram histogram;
+  EXPECT_THAT(histogram.quantileNanos(0.5), Eq(0));
+
+  histogram.buckets[LatencyHistogram::bucketFor(100)] = 90;
+  histogram.buckets[LatencyHistogram::bucketFor(5000)] = 10;
+  EXPECT_THAT(histogram.count(), Eq(100));
+  EXPECT_THAT(histogram.quantileNanos(0.5), Eq(128));
+  EXPECT_THAT(histogram.quantileNanos(0.9), Eq(128));
+  EXPECT_THAT(histogram.quantileNanos(0.99), Eq(8192));
+}
+
+TEST(MetricsTest, ShouldFormatMetrics) {
+  simple_tr8n::MetricsSnapshot<char> snapshot;
+  snapshot.hits.push_back({"test.no_args", 3});
+  snapshot.missingMsgTypes.push_back({"test.\"quoted\"", 1});
+  snapshot.numHits = 3;
+  snapshot.numMissingMsgTypes = 1;
+  snapshot.numMissingArgs = 2;
+  snapshot.latency.buckets[LatencyHistogram::bucketFor(100)] = 2;
+  snapshot.latency.sumNanos = 200;
+
+  const std::string text = simple_tr8n::formatMetrics(snapshot);
+  EXPECT_THAT(
+      text, HasSubstr("# TYPE simple_tr8n_msg_hits_total counter\n"
+                      "simple_tr8n_msg_hits_total{msg_type=\"test.no_args\"} 3\n"));
+  EXPECT_THAT(
+      text,
+      HasSubstr("simple_tr8n_missing_msg_type_hits_total{msg_type=\"test.\\\"quoted\\\"\"} 1\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_missing_msg_types_total 1\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_invalid_args_total 0\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_missing_args_total 2\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_render_latency_seconds_bucket{le=\"6.4e-08\"} 0\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_render_latency_seconds_bucket{le=\"1.28e-07\"} 2\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_render_latency_seconds_bucket{le=\"+Inf\"} 2\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_render_latency_seconds_sum 2e-07\n"));
+  EXPECT_THAT(text, HasSubstr("simple_tr8n_render_latency_seconds_count 2\n"));
+}
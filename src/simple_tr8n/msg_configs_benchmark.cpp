@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace {
+
+// Message types sharing a long namespace prefix, like real catalogs.
+std::vector<std::string> msgTypes(std::size_t numMsgs) {
+  std::vector<std::string> result;
+  result.reserve(numMsgs);
+  for (std::size_t i = 0; i < numMsgs; ++i) {
+    result.push_back("your_project.some.long.namespace.messages.msg_" + std::to_string(i));
+  }
+  return result;
+}
+
+std::unique_ptr<simple_tr8n::MsgConfigs<char>> makeConfigs(
+    const std::vector<std::string>& types, bool frozen,
+    simple_tr8n::KeyStorage keyStorage = simple_tr8n::KeyStorage::kFull) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->setKeyStorage(keyStorage);
+  for (const auto& msgType : types) {
+    configs->add(msgType, "A message with a %{arg} argument");
+  }
+  if (frozen) {
+    configs->freeze();
+  }
+  return configs;
+}
+
+// Looks up every message type, in a shuffled order.
+void lookupBenchmark(
+    benchmark::State& state, bool frozen,
+    simple_tr8n::KeyStorage keyStorage = simple_tr8n::KeyStorage::kFull) {
+  const auto numMsgs = static_cast<std::size_t>(state.range(0));
+  auto types = msgTypes(numMsgs);
+  const auto configs = makeConfigs(types, frozen, keyStorage);
+
+  std::shuffle(types.begin(), types.end(), std::mt19937{42});
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&configs->get(types[i]));
+    i = (i + 1 < numMsgs) ? i + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MapLookup(benchmark::State& state) {
+  lookupBenchmark(state, false);
+}
+BENCHMARK(BM_MapLookup)->Arg(1000)->Arg(10000)->Arg(100000);
+
+void BM_FrozenLookup(benchmark::State& state) {
+  lookupBenchmark(state, true);
+}
+BENCHMARK(BM_FrozenLookup)->Arg(1000)->Arg(10000)->Arg(100000);
+
+void BM_FrozenHashOnlyLookup(benchmark::State& state) {
+  lookupBenchmark(state, true, simple_tr8n::KeyStorage::kHashOnly);
+}
+BENCHMARK(BM_FrozenHashOnlyLookup)->Arg(1000)->Arg(10000)->Arg(100000);
+
+void BM_Freeze(benchmark::State& state) {
+  const auto types = msgTypes(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto configs = makeConfigs(types, false);
+    state.ResumeTiming();
+
+    configs->freeze();
+
+    state.PauseTiming();
+    configs.reset();
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_Freeze)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Destroys a whole catalog, like when unloading a locale.
+void teardownBenchmark(benchmark::State& state, bool frozen) {
+  const auto types = msgTypes(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto configs = makeConfigs(types, frozen);
+    state.ResumeTiming();
+
+    configs.reset();
+  }
+}
+
+void BM_MapTeardown(benchmark::State& state) {
+  teardownBenchmark(state, false);
+}
+BENCHMARK(BM_MapTeardown)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+void BM_FrozenTeardown(benchmark::State& state) {
+  teardownBenchmark(state, true);
+}
+BENCHMARK(BM_FrozenTeardown)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
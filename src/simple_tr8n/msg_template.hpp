@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_MSG_TEMPLATE_HPP
+#define SIMPLE_TR8N_MSG_TEMPLATE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/char_scan.hpp"
+#include "simple_tr8n/string_view.hpp"
+
+namespace simple_tr8n {
+namespace internal {
+
+/** MsgSegment::slot value for a span of literal text. */
+constexpr std::uint32_t kLiteralSlot = std::numeric_limits<std::uint32_t>::max();
+
+/** MsgSegment::slot value for an argument not (yet) bound to a slot index. */
+constexpr std::uint32_t kUnboundSlot = kLiteralSlot - 1;
+
+/**
+ * One piece of a parsed message template: either a span of literal text to
+ * copy as-is, or the argKey span of a %{argKey} token to substitute. Offsets
+ * are relative to the start of the message text the segment was parsed from.
+ */
+struct MsgSegment {
+  std::uint32_t offset;
+  std::uint32_t length;
+
+  /**
+   * kLiteralSlot for literal text. For arguments, the slot index shared by
+   * all of the message's arguments with the same argKey: either assigned in
+   * order of first appearance, or the index of argKey within the argument list
+   * the message was bound to (or kUnboundSlot).
+   */
+  std::uint32_t slot;
+
+  bool isArg() const { return slot != kLiteralSlot; }
+};
+
+/** Parsed form of a message, in output order. */
+using MsgSegments = std::vector<MsgSegment>;
+
+/**
+ * Returns the position of the first %{argKey} token at or after start in msg,
+ * or msg.size() if there is none. On success, sets keyEnd to the position of
+ * the closing brace (so the argKey spans [result + 2, keyEnd)).
+ *
+ * Matches the same tokens as the ECMAScript regex %\{(.*?)\}, which this
+ * library originally used: the argKey is the shortest run of characters up to
+ * the next '}', and may not contain a line terminator.
+ *
+ * Scans with the given instruction set (see findFirstOf()).
+ */
+template<typename CharT>
+std::size_t findArgToken(
+    basic_string_view<CharT> msg, std::size_t start, std::size_t& keyEnd,
+    ScanLevel level = bestScanLevel()) {
+  const CharT* const data = msg.data();
+  const std::size_t size = msg.size();
+  const CharT percent = CharT('%');
+
+  std::size_t pos = findFirstOf(level, data, start, size, percent, percent, percent);
+  while (pos + 1 < size) {
+    if (data[pos + 1] != CharT('{')) {
+      pos = findFirstOf(level, data, pos + 1, size, percent, percent, percent);
+      continue;
+    }
+
+    const std::size_t i =
+        findFirstOf(level, data, pos + 2, size, CharT('}'), CharT('\n'), CharT('\r'));
+    if (i == size) {
+      return size;  // No closing brace anywhere after this point.
+    }
+    if (data[i] == CharT('}')) {
+      keyEnd = i;
+      return pos;
+    }
+    // No token can span a line terminator, so resume after it.
+    pos = findFirstOf(level, data, i + 1, size, percent, percent, percent);
+  }
+
+  return size;
+}
+
+/** Parses msg into literal and argument segments. */
+template<typename CharT>
+MsgSegments parseMsgSegments(basic_string_view<CharT> msg, ScanLevel level = bestScanLevel()) {
+  Expects(msg.size() <= std::numeric_limits<std::uint32_t>::max());
+
+  MsgSegments segments;
+  const auto addSegment = [&](std::size_t offset, std::size_t length, std::uint32_t slot) {
+    segments.push_back(MsgSegment{
+        gsl::narrow_cast<std::uint32_t>(offset), gsl::narrow_cast<std::uint32_t>(length), slot});
+  };
+
+  std::size_t start = 0;
+  std::size_t keyEnd = 0;
+  for (std::size_t pos = findArgToken(msg, start, keyEnd, level); pos < msg.size();
+       pos = findArgToken(msg, start, keyEnd, level)) {
+    if (pos > start) {
+      addSegment(start, pos - start, kLiteralSlot);
+    }
+    addSegment(pos + 2, keyEnd - (pos + 2), kUnboundSlot);
+    start = keyEnd + 1;  // Advance past %{argKey} token.
+  }
+
+  // No more argument tokens. Add rest of message.
+  if (start < msg.size()) {
+    addSegment(start, msg.size() - start, kLiteralSlot);
+  }
+
+  return segments;
+}
+
+/** Returns the text (literal or argKey) of segment within msg. */
+template<typename CharT>
+basic_string_view<CharT> segmentText(basic_string_view<CharT> msg, const MsgSegment& segment) {
+  return msg.substr(segment.offset, segment.length);
+}
+
+/**
+ * Binds each argument segment to a slot shared by all argument segments with
+ * the same argKey. Slots are numbered in order of each argKey's first
+ * appearance, continuing after any argKeys already in slotKeys (to which new
+ * argKeys are appended).
+ */
+template<typename CharT>
+void assignArgSlots(
+    basic_string_view<CharT> msg, MsgSegments& segments,
+    std::vector<basic_string_view<CharT>>& slotKeys) {
+  for (auto& segment : segments) {
+    if (!segment.isArg()) {
+      continue;
+    }
+
+    const auto argKey = segmentText<CharT>(msg, segment);
+    const auto itr = std::find(slotKeys.begin(), slotKeys.end(), argKey);
+    segment.slot = gsl::narrow_cast<std::uint32_t>(itr - slotKeys.begin());
+    if (itr == slotKeys.end()) {
+      slotKeys.push_back(argKey);
+    }
+  }
+}
+
+/**
+ * Binds each argument segment to the index of its argKey within argKeys.
+ * Returns the first argument segment whose argKey isn't in argKeys (left as
+ * kUnboundSlot), or nullptr if all were bound.
+ */
+template<typename CharT>
+const MsgSegment* bindArgSlots(
+    basic_string_view<CharT> msg, MsgSegments& segments, const basic_string_view<CharT>* argKeys,
+    std::size_t numArgKeys) {
+  const MsgSegment* firstUnbound = nullptr;
+
+  for (auto& segment : segments) {
+    if (!segment.isArg()) {
+      continue;
+    }
+
+    const auto argKey = segmentText<CharT>(msg, segment);
+    segment.slot = kUnboundSlot;
+    for (std::size_t i = 0; i < numArgKeys; ++i) {
+      if (argKeys[i] == argKey) {
+        segment.slot = gsl::narrow_cast<std::uint32_t>(i);
+        break;
+      }
+    }
+
+    if (segment.slot == kUnboundSlot && firstUnbound == nullptr) {
+      firstUnbound = &segment;
+    }
+  }
+
+  return firstUnbound;
+}
+
+}  // namespace internal
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_MSG_TEMPLATE_HPP
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/char_scan.hpp"
+#include "simple_tr8n/msg_template.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace {
+
+using simple_tr8n::internal::ScanLevel;
+
+constexpr std::size_t kNumMsgs = 10000;
+
+template<typename CharT>
+std::basic_string<CharT> widen(const std::string& str) {
+  return std::basic_string<CharT>(str.begin(), str.end());
+}
+
+/**
+ * Catalog-like message bodies: mostly prose of varying length, with 0-3
+ * arguments and the occasional literal '%'.
+ */
+template<typename CharT>
+std::vector<std::basic_string<CharT>> makeMsgs() {
+  static const char* const kWords[] = {
+      "Your", "order", "has", "shipped", "and", "should", "arrive", "within", "a", "few", "days,",
+      "100%", "guaranteed.", "Please", "contact", "support", "if", "anything", "looks", "wrong."};
+  constexpr std::size_t kNumWords = sizeof(kWords) / sizeof(kWords[0]);
+
+  std::vector<std::basic_string<CharT>> msgs;
+  msgs.reserve(kNumMsgs);
+  for (std::size_t i = 0; i < kNumMsgs; ++i) {
+    std::string msg;
+    const std::size_t numWords = 4 + (i * 7) % 40;
+    for (std::size_t w = 0; w < numWords; ++w) {
+      msg += kWords[(i + w * 3) % kNumWords];
+      msg += (w % 11 == 5 && (i % 4) != 0) ? " %{arg" + std::to_string(w) + "} " : " ";
+    }
+    msgs.push_back(widen<CharT>(msg));
+  }
+  return msgs;
+}
+
+template<typename CharT>
+void reportChars(benchmark::State& state, const std::vector<std::basic_string<CharT>>& msgs) {
+  std::size_t numChars = 0;
+  for (const auto& msg : msgs) {
+    numChars += msg.size();
+  }
+  state.SetBytesProcessed(
+      static_cast<std::int64_t>(state.iterations() * numChars * sizeof(CharT)));
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * msgs.size()));
+}
+
+// Baseline: scanning with the regex this library originally used.
+template<typename CharT>
+void BM_RegexScan(benchmark::State& state) {
+  const auto msgs = makeMsgs<CharT>();
+  const CharT pattern[] = {'%', '\\', '{', '(', '.', '*', '?', ')', '\\', '}', '\0'};
+  const std::basic_regex<CharT> argPattern{pattern};
+  using Iterator = std::regex_iterator<typename std::basic_string<CharT>::const_iterator>;
+
+  for (auto _ : state) {
+    std::size_t numArgs = 0;
+    for (const auto& msg : msgs) {
+      for (Iterator itr{msg.begin(), msg.end(), argPattern}; itr != Iterator{}; ++itr) {
+        ++numArgs;
+      }
+    }
+    benchmark::DoNotOptimize(numArgs);
+  }
+  reportChars(state, msgs);
+}
+BENCHMARK_TEMPLATE(BM_RegexScan, char)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RegexScan, wchar_t)->Unit(benchmark::kMillisecond);
+
+// Parsing every message into segments with the given ScanLevel.
+template<typename CharT, ScanLevel Level>
+void BM_ParseMsgSegments(benchmark::State& state) {
+  if (Level > simple_tr8n::internal::bestScanLevel()) {
+    state.SkipWithError("ScanLevel not supported by this build or CPU");
+    return;
+  }
+
+  const auto msgs = makeMsgs<CharT>();
+  for (auto _ : state) {
+    for (const auto& msg : msgs) {
+      benchmark::DoNotOptimize(simple_tr8n::internal::parseMsgSegments<CharT>(
+          simple_tr8n::basic_string_view<CharT>{msg.data(), msg.size()}, Level));
+    }
+  }
+  reportChars(state, msgs);
+}
+BENCHMARK_TEMPLATE(BM_ParseMsgSegments, char, ScanLevel::kScalar);
+BENCHMARK_TEMPLATE(BM_ParseMsgSegments, char, ScanLevel::kSse2);
+BENCHMARK_TEMPLATE(BM_ParseMsgSegments, char, ScanLevel::kAvx2);
+BENCHMARK_TEMPLATE(BM_ParseMsgSegments, wchar_t, ScanLevel::kScalar);
+BENCHMARK_TEMPLATE(BM_ParseMsgSegments, wchar_t, ScanLevel::kSse2);
+BENCHMARK_TEMPLATE(BM_ParseMsgSegments, wchar_t, ScanLevel::kAvx2);
+
+// Startup cost of one locale: adding every message and freezing.
+template<typename CharT>
+void BM_BuildCatalog(benchmark::State& state) {
+  const auto msgs = makeMsgs<CharT>();
+  std::vector<std::basic_string<CharT>> types;
+  for (std::size_t i = 0; i < msgs.size(); ++i) {
+    types.push_back(widen<CharT>("your_project.messages.msg_" + std::to_string(i)));
+  }
+
+  for (auto _ : state) {
+    auto configs = std::make_unique<simple_tr8n::MsgConfigs<CharT>>();
+    for (std::size_t i = 0; i < msgs.size(); ++i) {
+      configs->add(types[i], msgs[i]);
+    }
+    configs->freeze();
+    benchmark::DoNotOptimize(configs.get());
+  }
+  reportChars(state, msgs);
+}
+BENCHMARK_TEMPLATE(BM_BuildCatalog, char)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BuildCatalog, wchar_t)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/char_scan.hpp"
+#include "simple_tr8n/msg_template.hpp"
+
+namespace {
+
+// Describes parsed segments as strings, with argument keys written as {key}.
+template<typename CharT>
+std::vector<std::basic_string<CharT>> describe(
+    simple_tr8n::basic_string_view<CharT> msg,
+    simple_tr8n::internal::ScanLevel level = simple_tr8n::internal::bestScanLevel()) {
+  std::vector<std::basic_string<CharT>> result;
+  for (const auto& segment : simple_tr8n::internal::parseMsgSegments<CharT>(msg, level)) {
+    const auto text = simple_tr8n::internal::segmentText<CharT>(msg, segment);
+    std::basic_string<CharT> described;
+    if (segment.isArg()) {
+      described.push_back(CharT('{'));
+    }
+    described.append(text.data(), text.size());
+    if (segment.isArg()) {
+      described.push_back(CharT('}'));
+    }
+    result.push_back(described);
+  }
+  return result;
+}
+
+// Same as describe(), but using the %\{(.*?)\} regex this library originally
+// parsed messages with.
+template<typename CharT>
+std::vector<std::basic_string<CharT>> describeWithRegex(const std::basic_string<CharT>& msg) {
+  const CharT pattern[] = {'%', '\\', '{', '(', '.', '*', '?', ')', '\\', '}', '\0'};
+  const std::basic_regex<CharT> argPattern{pattern};
+
+  std::vector<std::basic_string<CharT>> result;
+  std::size_t start = 0;
+  using Iterator = std::regex_iterator<typename std::basic_string<CharT>::const_iterator>;
+  for (Iterator itr{msg.begin(), msg.end(), argPattern}; itr != Iterator{}; ++itr) {
+    const auto pos = static_cast<std::size_t>(itr->position(0));
+    if (pos > start) {
+      result.push_back(msg.substr(start, pos - start));
+    }
+    result.push_back(CharT('{') + itr->str(1) + CharT('}'));
+    start = pos + static_cast<std::size_t>(itr->length(0));
+  }
+  if (start < msg.size()) {
+    result.push_back(msg.substr(start));
+  }
+  return result;
+}
+
+// Random messages mostly made of characters significant to parsing, of lengths
+// spanning several SIMD blocks.
+template<typename CharT>
+std::vector<std::basic_string<CharT>> randomMsgs(std::size_t count) {
+  const CharT alphabet[] = {'%', '%', '{', '{', '}', '}', '\n', '\r', 'a', 'b', ' ', CharT(0x25ff)};
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<std::size_t> lengthDist{0, 100};
+  std::uniform_int_distribution<std::size_t> charDist{0, sizeof(alphabet) / sizeof(CharT) - 1};
+
+  std::vector<std::basic_string<CharT>> msgs;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::basic_string<CharT> msg(lengthDist(rng), CharT('x'));
+    for (auto& ch : msg) {
+      // Keep most characters plain, so tokens are sometimes found far apart.
+      if (charDist(rng) % 3 == 0) {
+        ch = alphabet[charDist(rng)];
+      }
+    }
+    msgs.push_back(msg);
+  }
+  return msgs;
+}
+
+// Expects parsing random messages at every supported ScanLevel to match
+// regex parsing (or scalar parsing, for character types std::regex can't use).
+template<typename CharT>
+void expectSameAsReference(bool useRegex) {
+  using simple_tr8n::internal::ScanLevel;
+  const auto best = simple_tr8n::internal::bestScanLevel();
+
+  for (const auto& msg : randomMsgs<CharT>(2000)) {
+    const simple_tr8n::basic_string_view<CharT> view{msg.data(), msg.size()};
+    const auto expected =
+        useRegex ? describeWithRegex(msg) : describe<CharT>(view, ScanLevel::kScalar);
+    for (const auto level : {ScanLevel::kScalar, ScanLevel::kSse2, ScanLevel::kAvx2}) {
+      if (level <= best) {
+        ASSERT_EQ(describe<CharT>(view, level), expected) << "at level " << static_cast<int>(level);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(MsgTemplateTest, ShouldParseLiteralOnlyMessages) {
+  EXPECT_THAT(describe<char>(""), IsEmpty());
+  EXPECT_THAT(describe<char>("no arguments"), ElementsAre("no arguments"));
+  EXPECT_THAT(describe<char>("100% {sure}"), ElementsAre("100% {sure}"));
+}
+
+TEST(MsgTemplateTest, ShouldParseArguments) {
+  EXPECT_THAT(describe<char>("hello, %{personName}!"), ElementsAre("hello, ", "{personName}", "!"));
+  EXPECT_THAT(describe<char>("progress: %{pct}%"), ElementsAre("progress: ", "{pct}", "%"));
+  EXPECT_THAT(describe<char>("%{a}%{b}"), ElementsAre("{a}", "{b}"));
+  EXPECT_THAT(describe<char>("%{a} / %{a}"), ElementsAre("{a}", " / ", "{a}"));
+}
+
+TEST(MsgTemplateTest, ShouldMatchShortestArgKey) {
+  EXPECT_THAT(describe<char>("%{a}}"), ElementsAre("{a}", "}"));
+  EXPECT_THAT(describe<char>("%{%{a}"), ElementsAre("{%{a}"));
+  EXPECT_THAT(describe<char>("%%{a}"), ElementsAre("%", "{a}"));
+  EXPECT_THAT(describe<char>("%{}"), ElementsAre("{}"));
+}
+
+TEST(MsgTemplateTest, ShouldIgnoreUnterminatedTokens) {
+  EXPECT_THAT(describe<char>("%{a"), ElementsAre("%{a"));
+  EXPECT_THAT(describe<char>("%"), ElementsAre("%"));
+  EXPECT_THAT(describe<char>("%{a\n} %{b}"), ElementsAre("%{a\n} ", "{b}"));
+  EXPECT_THAT(describe<char>("%{a\r%{b}"), ElementsAre("%{a\r", "{b}"));
+}
+
+TEST(MsgTemplateTest, ShouldParseWideChars) {
+  EXPECT_THAT(
+      describe<wchar_t>(L"hello, %{personName}!"), ElementsAre(L"hello, ", L"{personName}", L"!"));
+}
+
+TEST(MsgTemplateTest, ShouldParseSameAsRegex) {
+  expectSameAsReference<char>(true);
+  expectSameAsReference<wchar_t>(true);
+  expectSameAsReference<char16_t>(false);  // Covers 2 byte characters where wchar_t is 4 bytes.
+}
+
+TEST(CharScanTest, ShouldFindFirstOfAtEveryLevel) {
+  using simple_tr8n::internal::ScanLevel;
+  const std::string text(100, 'x');
+
+  for (const auto level : {ScanLevel::kScalar, ScanLevel::kSse2, ScanLevel::kAvx2}) {
+    if (level > simple_tr8n::internal::bestScanLevel()) {
+      continue;
+    }
+    for (std::size_t target = 0; target < text.size(); ++target) {
+      std::string msg = text;
+      msg[target] = '}';
+      for (std::size_t start = 0; start <= target; start += 7) {
+        EXPECT_EQ(
+            simple_tr8n::internal::findFirstOf(level, msg.data(), start, msg.size(), '%', '}', '%'),
+            target);
+      }
+      EXPECT_EQ(
+          simple_tr8n::internal::findFirstOf(level, msg.data(), 0, target, '}', '}', '}'), target);
+    }
+  }
+}
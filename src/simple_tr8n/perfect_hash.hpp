@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_PERFECT_HASH_HPP
+#define SIMPLE_TR8N_PERFECT_HASH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/string_view.hpp"
+
+namespace simple_tr8n {
+namespace internal {
+
+/** 64-bit hash of the given bytes (MurmurHash64A). */
+inline std::uint64_t hashBytes(const void* data, std::size_t length, std::uint64_t seed) {
+  constexpr std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+  constexpr int r = 47;
+
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  std::uint64_t h = seed ^ (length * m);
+
+  const std::size_t numBlocks = length / 8;
+  for (std::size_t i = 0; i < numBlocks; ++i) {
+    std::uint64_t k;
+    std::memcpy(&k, bytes + (i * 8), sizeof(k));
+
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+
+    h ^= k;
+    h *= m;
+  }
+
+  const unsigned char* tail = bytes + (numBlocks * 8);
+  const std::size_t tailLength = length & 7;
+  if (tailLength > 0) {
+    for (std::size_t i = tailLength; i > 0; --i) {
+      h ^= static_cast<std::uint64_t>(tail[i - 1]) << (8 * (i - 1));
+    }
+    h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+/** 64-bit hash of a message type key. */
+template<typename CharT>
+std::uint64_t hashKey(basic_string_view<CharT> key, std::uint64_t seed) {
+  return hashBytes(key.data(), key.size() * sizeof(CharT), seed);
+}
+
+/** Bijective 64-bit mixing function (splitmix64 finalizer). */
+inline std::uint64_t mix64(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/** Maps a 32-bit value x uniformly onto [0, n) without division. */
+inline std::uint32_t fastRange(std::uint32_t x, std::uint32_t n) {
+  return static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * n) >> 32);
+}
+
+/**
+ * Minimal perfect hash function over a fixed set of distinct 64-bit key
+ * hashes, built with the hash-and-displace technique: keys are grouped into
+ * small buckets, and each bucket gets a pilot value that displaces all of its
+ * keys into slots not used by any other bucket.
+ *
+ * Maps each of the n key hashes it was built from to a distinct slot in
+ * [0, n). Other hashes map to arbitrary slots, so callers must verify the key
+ * stored in the slot.
+ */
+class PerfectHash {
+public:
+  /** Average number of keys per bucket (trades build time for table size). */
+  static constexpr std::size_t kKeysPerBucket = 4;
+
+  PerfectHash() = default;
+  ~PerfectHash() = default;
+
+  PerfectHash(const PerfectHash&) = delete;
+  PerfectHash& operator=(const PerfectHash&) = delete;
+
+  // Note: Moving a vector keeps its elements in place, so pilots_ stays valid.
+  PerfectHash(PerfectHash&&) = default;
+  PerfectHash& operator=(PerfectHash&&) = default;
+
+  /**
+   * Builds over the given key hashes. Returns false (leaving this empty) if
+   * any hashes are equal, in which case the keys should be rehashed with a
+   * different seed.
+   *
+   * Construction is deterministic: the same set of hashes, in any order,
+   * always produces the same slot assignments.
+   */
+  bool build(const std::vector<std::uint64_t>& hashes) {
+    ownedPilots_.clear();
+    pilots_ = nullptr;
+    numBuckets_ = 0;
+    numSlots_ = 0;
+
+    Expects(hashes.size() < std::numeric_limits<std::uint32_t>::max());
+    const auto numKeys = gsl::narrow_cast<std::uint32_t>(hashes.size());
+    if (numKeys == 0) {
+      return true;
+    }
+
+    std::vector<std::uint64_t> sorted = hashes;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+      return false;
+    }
+
+    const auto numBuckets =
+        gsl::narrow_cast<std::uint32_t>((numKeys + kKeysPerBucket - 1) / kKeysPerBucket);
+
+    // Group (sorted) hashes by bucket.
+    std::vector<std::uint32_t> bucketStarts(numBuckets + 1, 0);
+    for (const auto hash : sorted) {
+      ++bucketStarts[bucketOf(hash, numBuckets) + 1];
+    }
+    for (std::uint32_t b = 0; b < numBuckets; ++b) {
+      bucketStarts[b + 1] += bucketStarts[b];
+    }
+    std::vector<std::uint64_t> bucketHashes(numKeys);
+    std::vector<std::uint32_t> fill(bucketStarts.begin(), bucketStarts.end() - 1);
+    for (const auto hash : sorted) {
+      bucketHashes[fill[bucketOf(hash, numBuckets)]++] = hash;
+    }
+
+    // Place largest buckets first, while there are the most free slots.
+    std::vector<std::uint32_t> order(numBuckets);
+    for (std::uint32_t b = 0; b < numBuckets; ++b) {
+      order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+      return (bucketStarts[a + 1] - bucketStarts[a]) > (bucketStarts[b + 1] - bucketStarts[b]);
+    });
+
+    std::vector<std::uint32_t> pilots(numBuckets, 0);
+    std::vector<bool> taken(numKeys, false);
+    std::vector<std::uint32_t> bucketSlots;
+
+    for (const auto b : order) {
+      const std::uint32_t begin = bucketStarts[b];
+      const std::uint32_t end = bucketStarts[b + 1];
+      if (begin == end) {
+        continue;
+      }
+
+      for (std::uint32_t pilot = 0;; ++pilot) {
+        bucketSlots.clear();
+        bool fits = true;
+
+        for (std::uint32_t i = begin; (i < end) && fits; ++i) {
+          const std::uint32_t slot = slotOf(bucketHashes[i], pilot, numKeys);
+          fits = !taken[slot]
+              && (std::find(bucketSlots.begin(), bucketSlots.end(), slot) == bucketSlots.end());
+          bucketSlots.push_back(slot);
+        }
+
+        if (fits) {
+          for (const auto slot : bucketSlots) {
+            taken[slot] = true;
+          }
+          pilots[b] = pilot;
+          break;
+        }
+      }
+    }
+
+    ownedPilots_ = std::move(pilots);
+    pilots_ = ownedPilots_.data();
+    numBuckets_ = numBuckets;
+    numSlots_ = numKeys;
+    return true;
+  }
+
+  /**
+   * Uses pilot values previously built over numSlots keys (see pilots()) in
+   * place, without copying them. They must outlive this PerfectHash. Returns
+   * false if the number of pilots doesn't match numSlots.
+   */
+  bool view(const std::uint32_t* pilots, std::size_t numPilots, std::size_t numSlots) {
+    if (numSlots >= std::numeric_limits<std::uint32_t>::max()
+        || numPilots != (numSlots + kKeysPerBucket - 1) / kKeysPerBucket) {
+      return false;
+    }
+
+    ownedPilots_.clear();
+    pilots_ = pilots;
+    numBuckets_ = gsl::narrow_cast<std::uint32_t>(numPilots);
+    numSlots_ = gsl::narrow_cast<std::uint32_t>(numSlots);
+    return true;
+  }
+
+  /** Pilot values, one per bucket, which fully determine the slot mapping. */
+  gsl::span<const std::uint32_t> pilots() const {
+    return gsl::span<const std::uint32_t>{pilots_, numBuckets_};
+  }
+
+  /** Number of slots (equal to the number of keys built over). */
+  std::size_t size() const { return numSlots_; }
+
+  /** Returns the slot for the given key hash. Requires size() > 0. */
+  std::size_t slot(std::uint64_t hash) const {
+    return slotOf(hash, pilots_[bucketOf(hash, numBuckets_)], numSlots_);
+  }
+
+private:
+  static std::uint32_t bucketOf(std::uint64_t hash, std::uint32_t numBuckets) {
+    return fastRange(static_cast<std::uint32_t>(hash), numBuckets);
+  }
+
+  static std::uint32_t slotOf(std::uint64_t hash, std::uint32_t pilot, std::uint32_t numSlots) {
+    const std::uint64_t mixed = mix64(hash ^ (pilot * 0x9e3779b97f4a7c15ULL));
+    return fastRange(static_cast<std::uint32_t>(mixed >> 32), numSlots);
+  }
+
+  std::vector<std::uint32_t> ownedPilots_;  // Empty if viewing external pilots.
+  const std::uint32_t* pilots_ = nullptr;   // One per bucket.
+  std::uint32_t numBuckets_ = 0;
+  std::uint32_t numSlots_ = 0;
+};
+
+}  // namespace internal
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_PERFECT_HASH_HPP
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/perfect_hash.hpp"
+
+namespace {
+
+std::vector<std::uint64_t> keyHashes(std::size_t numKeys) {
+  std::vector<std::uint64_t> hashes;
+  for (std::size_t i = 0; i < numKeys; ++i) {
+    const std::string key = "your_project.some.long.namespace.msg_" + std::to_string(i);
+    hashes.push_back(simple_tr8n::internal::hashKey<char>(key, 0));
+  }
+  return hashes;
+}
+
+std::vector<std::size_t> slots(
+    const simple_tr8n::internal::PerfectHash& index, const std::vector<std::uint64_t>& hashes) {
+  std::vector<std::size_t> result;
+  for (const auto hash : hashes) {
+    result.push_back(index.slot(hash));
+  }
+  return result;
+}
+
+}  // namespace
+
+using ::testing::Eq;
+using ::testing::Ne;
+
+TEST(PerfectHashTest, ShouldMapKeysToDistinctSlots) {
+  for (const std::size_t numKeys : {0, 1, 2, 3, 5, 17, 100, 1000, 10000}) {
+    const auto hashes = keyHashes(numKeys);
+
+    simple_tr8n::internal::PerfectHash index;
+    ASSERT_TRUE(index.build(hashes));
+    EXPECT_THAT(index.size(), Eq(numKeys));
+
+    auto sortedSlots = slots(index, hashes);
+    std::sort(sortedSlots.begin(), sortedSlots.end());
+    for (std::size_t i = 0; i < numKeys; ++i) {
+      ASSERT_THAT(sortedSlots[i], Eq(i)) << "numKeys: " << numKeys;
+    }
+  }
+}
+
+TEST(PerfectHashTest, ShouldBeIndependentOfKeyOrder) {
+  const auto hashes = keyHashes(500);
+  auto reversed = hashes;
+  std::reverse(reversed.begin(), reversed.end());
+
+  simple_tr8n::internal::PerfectHash index;
+  ASSERT_TRUE(index.build(hashes));
+  simple_tr8n::internal::PerfectHash reversedIndex;
+  ASSERT_TRUE(reversedIndex.build(reversed));
+
+  EXPECT_THAT(slots(reversedIndex, hashes), Eq(slots(index, hashes)));
+}
+
+TEST(PerfectHashTest, ShouldViewBuiltPilots) {
+  const auto hashes = keyHashes(100);
+  simple_tr8n::internal::PerfectHash index;
+  ASSERT_TRUE(index.build(hashes));
+
+  const std::vector<std::uint32_t> pilots(index.pilots().begin(), index.pilots().end());
+  simple_tr8n::internal::PerfectHash viewIndex;
+  ASSERT_TRUE(viewIndex.view(pilots.data(), pilots.size(), index.size()));
+  EXPECT_THAT(slots(viewIndex, hashes), Eq(slots(index, hashes)));
+
+  EXPECT_FALSE(viewIndex.view(pilots.data(), pilots.size() - 1, index.size()));
+}
+
+TEST(PerfectHashTest, ShouldRejectDuplicateHashes) {
+  auto hashes = keyHashes(10);
+  hashes.push_back(hashes[3]);
+
+  simple_tr8n::internal::PerfectHash index;
+  EXPECT_FALSE(index.build(hashes));
+  EXPECT_THAT(index.size(), Eq(0u));
+}
+
+TEST(PerfectHashTest, ShouldHashCharsAndSeedsDifferently) {
+  EXPECT_THAT(
+      simple_tr8n::internal::hashKey<char>("test.key", 0),
+      Ne(simple_tr8n::internal::hashKey<char>("test.kez", 0)));
+  EXPECT_THAT(
+      simple_tr8n::internal::hashKey<char>("test.key", 0),
+      Ne(simple_tr8n::internal::hashKey<char>("test.key", 1)));
+  EXPECT_THAT(
+      simple_tr8n::internal::hashKey<char>("test.key", 0),
+      Ne(simple_tr8n::internal::hashKey<wchar_t>(L"test.key", 0)));
+}
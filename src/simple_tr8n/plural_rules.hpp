@@ -0,0 +1,432 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_PLURAL_RULES_HPP
+#define SIMPLE_TR8N_PLURAL_RULES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/string_view.hpp"
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  #include "simple_tr8n/exceptions.hpp"
+#endif
+
+namespace simple_tr8n {
+
+/** CLDR plural categories, in the order PluralRules evaluates them. */
+enum class PluralCategory : std::uint8_t { kZero, kOne, kTwo, kFew, kMany, kOther };
+
+constexpr std::size_t kNumPluralCategories = 6;
+
+/** Returns the CLDR name of category ("zero", "one", "two", "few", "many" or "other"). */
+inline const char* pluralCategoryName(PluralCategory category) {
+  static const char* const kNames[kNumPluralCategories] = {
+      "zero", "one", "two", "few", "many", "other"};
+  return kNames[static_cast<std::size_t>(category)];
+}
+
+/** Sets category from its CLDR name. Returns false if name isn't one. */
+inline bool parsePluralCategory(basic_string_view<char> name, PluralCategory& category) {
+  for (std::size_t i = 0; i < kNumPluralCategories; ++i) {
+    const auto candidate = static_cast<PluralCategory>(i);
+    if (name == basic_string_view<char>{pluralCategoryName(candidate)}) {
+      category = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace internal {
+
+/** Inclusive range of operand values, as its low end and (high - low). */
+struct PluralRange {
+  std::uint64_t low;
+  std::uint64_t width;
+};
+
+/** Compiled relation of a plural rule: true if ((n % modulus) in ranges) != negate. */
+struct PluralRelation {
+  std::uint64_t modulus;  // 0 if none.
+  std::uint32_t firstRange;
+  std::uint32_t numRanges;
+  bool negate;
+  bool endsConjunction;  // Last relation of an "and" chain.
+};
+
+/** Plural rule compiled to a disjunction of conjunctions of relations on n. */
+struct CompiledPluralRule {
+  std::vector<PluralRelation> relations;
+  std::vector<PluralRange> ranges;
+  bool alwaysTrue = false;  // Some conjunction holds for every integer.
+
+  bool matches(std::uint64_t n) const {
+    // Note: Evaluates whole conjunctions, combining results with bitwise ops,
+    // so the only data-dependent branch is taken once per conjunction.
+    bool conjunction = true;
+    for (const auto& relation : relations) {
+      const std::uint64_t x = (relation.modulus != 0) ? n % relation.modulus : n;
+      bool inRanges = false;
+      for (std::uint32_t i = 0; i < relation.numRanges; ++i) {
+        const PluralRange& range = ranges[relation.firstRange + i];
+        inRanges |= (x - range.low) <= range.width;
+      }
+      conjunction &= (inRanges != relation.negate);
+
+      if (relation.endsConjunction) {
+        if (conjunction) {
+          return true;
+        }
+        conjunction = true;
+      }
+    }
+    return alwaysTrue;
+  }
+};
+
+/**
+ * Parses the CLDR plural rule syntax (Unicode TR35, "Plural rules syntax")
+ * into a CompiledPluralRule:
+ *
+ *     condition = and_condition ("or" and_condition)*
+ *     and_condition = relation ("and" relation)*
+ *     relation = operand (("%" | "mod") value)? ("=" | "!=") range_list
+ *     range_list = (value | value ".." value) ("," range_list)*
+ *
+ * Trailing @integer and @decimal samples are ignored. Counts are always
+ * integers, so operands v, w, f, t, c and e are 0 (and n equals i): relations
+ * on them are folded into constants, dropping conjunctions that can never hold.
+ */
+class PluralRuleParser {
+public:
+  PluralRuleParser(basic_string_view<char> rule, CompiledPluralRule& compiled)
+      : rule_{rule}, compiled_{compiled} {}
+
+  /** Returns nullptr on success, or a description of the problem. */
+  const char* parse() {
+    compiled_ = CompiledPluralRule{};
+    const std::size_t samples = rule_.find('@');
+    if (samples != basic_string_view<char>::npos) {
+      rule_ = rule_.substr(0, samples);
+    }
+
+    skipSpaces();
+    if (pos_ == rule_.size()) {
+      return "empty rule";
+    }
+
+    do {
+      if (const char* problem = parseConjunction()) {
+        return problem;
+      }
+    } while (consumeWord("or"));
+
+    return (pos_ == rule_.size()) ? nullptr : "unexpected text";
+  }
+
+private:
+  static constexpr std::size_t kMaxValueDigits = 18;
+
+  const char* parseConjunction() {
+    const std::size_t firstRelation = compiled_.relations.size();
+    const std::size_t firstRange = compiled_.ranges.size();
+    bool constantFalse = false;
+
+    do {
+      bool constant = false;
+      bool constantValue = false;
+      if (const char* problem = parseRelation(constant, constantValue)) {
+        return problem;
+      }
+      constantFalse |= (constant && !constantValue);
+    } while (consumeWord("and"));
+
+    if (constantFalse) {
+      compiled_.relations.resize(firstRelation);
+      compiled_.ranges.resize(firstRange);
+    } else if (compiled_.relations.size() == firstRelation) {
+      compiled_.alwaysTrue = true;
+    } else {
+      compiled_.relations.back().endsConjunction = true;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Appends a relation on n, or sets constant and constantValue for one on an
+   * operand that is always 0.
+   */
+  const char* parseRelation(bool& constant, bool& constantValue) {
+    if (pos_ == rule_.size()) {
+      return "missing operand";
+    }
+    const char operand = rule_[pos_];
+    const basic_string_view<char> kOperands{"nivwftce"};
+    if (kOperands.find(operand) == basic_string_view<char>::npos || isLetterAt(pos_ + 1)) {
+      return "invalid operand";
+    }
+    ++pos_;
+    skipSpaces();
+    constant = (operand != 'n') && (operand != 'i');
+
+    std::uint64_t modulus = 0;
+    if (consumeSymbol("%") || consumeWord("mod")) {
+      if (!parseValue(modulus) || modulus == 0) {
+        return "invalid modulus";
+      }
+    }
+
+    bool negate = false;
+    if (consumeSymbol("!=")) {
+      negate = true;
+    } else if (!consumeSymbol("=")) {
+      return "expected = or !=";
+    }
+
+    const auto firstRange = gsl::narrow_cast<std::uint32_t>(compiled_.ranges.size());
+    do {
+      std::uint64_t low = 0;
+      std::uint64_t high = 0;
+      if (!parseValue(low)) {
+        return "invalid value";
+      }
+      high = low;
+      if (consumeSymbol("..") && (!parseValue(high) || high < low)) {
+        return "invalid range";
+      }
+      compiled_.ranges.push_back(PluralRange{low, high - low});
+    } while (consumeSymbol(","));
+
+    if (constant) {
+      constantValue = negate;
+      for (std::size_t i = firstRange; i < compiled_.ranges.size(); ++i) {
+        if (compiled_.ranges[i].low == 0) {
+          constantValue = !negate;
+        }
+      }
+      compiled_.ranges.resize(firstRange);
+      return nullptr;
+    }
+
+    const auto numRanges = gsl::narrow_cast<std::uint32_t>(compiled_.ranges.size() - firstRange);
+    compiled_.relations.push_back(PluralRelation{modulus, firstRange, numRanges, negate, false});
+    return nullptr;
+  }
+
+  bool parseValue(std::uint64_t& value) {
+    const std::size_t begin = pos_;
+    value = 0;
+    while (pos_ < rule_.size() && rule_[pos_] >= '0' && rule_[pos_] <= '9') {
+      value = value * 10 + static_cast<std::uint64_t>(rule_[pos_] - '0');
+      ++pos_;
+    }
+    const std::size_t numDigits = pos_ - begin;
+    skipSpaces();
+    return (numDigits > 0) && (numDigits <= kMaxValueDigits);
+  }
+
+  bool consumeSymbol(basic_string_view<char> symbol) {
+    if (rule_.substr(pos_, symbol.size()) != symbol) {
+      return false;
+    }
+    pos_ += symbol.size();
+    skipSpaces();
+    return true;
+  }
+
+  bool consumeWord(basic_string_view<char> word) {
+    if (rule_.substr(pos_, word.size()) != word || isLetterAt(pos_ + word.size())) {
+      return false;
+    }
+    pos_ += word.size();
+    skipSpaces();
+    return true;
+  }
+
+  bool isLetterAt(std::size_t pos) const {
+    return pos < rule_.size() && ((rule_[pos] >= 'a' && rule_[pos] <= 'z')
+                                     || (rule_[pos] >= 'A' && rule_[pos] <= 'Z'));
+  }
+
+  void skipSpaces() {
+    while (pos_ < rule_.size() && (rule_[pos_] == ' ' || rule_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  basic_string_view<char> rule_;
+  CompiledPluralRule& compiled_;
+  std::size_t pos_ = 0;
+};
+
+/** Built-in CLDR rules for languages sharing the same plural rules. */
+struct LanguagePluralRules {
+  const char* languages;  // Space separated.
+  const char* rules[kNumPluralCategories - 1];  // By category, excluding kOther. Null if none.
+};
+
+// From CLDR 44 plurals.xml, for some widely used languages.
+constexpr LanguagePluralRules kLanguagePluralRules[] = {
+    {"ja ko zh th vi id ms lo my", {}},
+    {"en de nl sv da nb nn no fi et el hu bg ca gl eu ur sw",
+     {nullptr, "i = 1 and v = 0", nullptr, nullptr, nullptr}},
+    {"it", {nullptr, "i = 1 and v = 0", nullptr, nullptr,
+            "e = 0 and i != 0 and i % 1000000 = 0 and v = 0 or e != 0..5"}},
+    {"es", {nullptr, "n = 1", nullptr, nullptr,
+            "e = 0 and i != 0 and i % 1000000 = 0 and v = 0 or e != 0..5"}},
+    {"fr", {nullptr, "i = 0,1", nullptr, nullptr,
+            "e = 0 and i != 0 and i % 1000000 = 0 and v = 0 or e != 0..5"}},
+    {"pt", {nullptr, "i = 0..1", nullptr, nullptr,
+            "e = 0 and i != 0 and i % 1000000 = 0 and v = 0 or e != 0..5"}},
+    {"tr az ka kk ky mn sq uz", {nullptr, "n = 1", nullptr, nullptr, nullptr}},
+    {"hi bn fa gu kn zu am", {nullptr, "i = 0 or n = 1", nullptr, nullptr, nullptr}},
+    {"ru uk",
+     {nullptr, "v = 0 and i % 10 = 1 and i % 100 != 11", nullptr,
+      "v = 0 and i % 10 = 2..4 and i % 100 != 12..14",
+      "v = 0 and i % 10 = 0 or v = 0 and i % 10 = 5..9 or v = 0 and i % 100 = 11..14"}},
+    {"pl",
+     {nullptr, "i = 1 and v = 0", nullptr, "v = 0 and i % 10 = 2..4 and i % 100 != 12..14",
+      "v = 0 and i != 1 and i % 10 = 0..1 or v = 0 and i % 10 = 5..9"
+      " or v = 0 and i % 100 = 12..14"}},
+    {"cs sk", {nullptr, "i = 1 and v = 0", nullptr, "i = 2..4 and v = 0", "v != 0"}},
+    {"lt",
+     {nullptr, "n % 10 = 1 and n % 100 != 11..19", nullptr,
+      "n % 10 = 2..9 and n % 100 != 11..19", "f != 0"}},
+    {"ro",
+     {nullptr, "i = 1 and v = 0", nullptr, "v != 0 or n = 0 or n != 1 and n % 100 = 1..19",
+      nullptr}},
+    {"he", {nullptr, "i = 1 and v = 0 or i = 0 and v != 0", "i = 2 and v = 0", nullptr, nullptr}},
+    {"ar", {"n = 0", "n = 1", "n = 2", "n % 100 = 3..10", "n % 100 = 11..99"}},
+    {"cy", {"n = 0", "n = 1", "n = 2", "n = 3", "n = 6"}},
+    {"ga", {nullptr, "n = 1", "n = 2", "n = 3..6", "n = 7..10"}},
+};
+
+}  // namespace internal
+
+/**
+ * Plural rules of a locale, selecting the PluralCategory for a count.
+ *
+ * Each category's CLDR rule expression is compiled once (see
+ * internal::PluralRuleParser), and the categories of counts below
+ * kTableSize (which cover nearly all real counts) are precomputed, so
+ * select() is a single table lookup for them. Larger counts evaluate the
+ * compiled rules, which costs a handful of comparisons per relation.
+ */
+class PluralRules {
+public:
+  static constexpr std::size_t kTableSize = 256;
+
+  /** Rules selecting PluralCategory::kOther for every count. */
+  PluralRules() { table_.fill(PluralCategory::kOther); }
+
+  ~PluralRules() = default;
+
+  PluralRules(const PluralRules&) = default;
+  PluralRules& operator=(const PluralRules&) = default;
+
+  PluralRules(PluralRules&&) = default;
+  PluralRules& operator=(PluralRules&&) = default;
+
+  /**
+   * Returns the built-in CLDR rules for the given language (e.g. "ru" or
+   * "pt-BR", matched by primary language subtag), or rules selecting only
+   * PluralCategory::kOther if it isn't built in (set rules for it with
+   * setRule() instead).
+   */
+  static PluralRules forLanguage(basic_string_view<char> language) {
+    const std::size_t end = language.find_first_of("-_");
+    std::string primary{language.data(), std::min(end, language.size())};
+    for (auto& ch : primary) {
+      ch = (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+    }
+
+    PluralRules rules;
+    for (const auto& entry : internal::kLanguagePluralRules) {
+      if (!hasWord(entry.languages, primary)) {
+        continue;
+      }
+      for (std::size_t i = 0; i + 1 < kNumPluralCategories; ++i) {
+        if (entry.rules[i] != nullptr) {
+          // Note: Built-in rules are always valid.
+          static_cast<void>(rules.setRule(static_cast<PluralCategory>(i), entry.rules[i]));
+        }
+      }
+      break;
+    }
+    return rules;
+  }
+
+  /**
+   * Sets the CLDR rule expression for category (which can't be kOther, since
+   * that's selected whenever no other rule matches), e.g. "v = 0 and i % 10 =
+   * 2..4 and i % 100 != 12..14". Returns false, leaving the rules unchanged,
+   * if the expression is invalid (throws InvalidPluralRuleException instead,
+   * if exceptions are enabled).
+   */
+  bool setRule(PluralCategory category, basic_string_view<char> rule) {
+    Expects(category != PluralCategory::kOther);
+
+    internal::CompiledPluralRule compiled;
+    const char* const problem = internal::PluralRuleParser{rule, compiled}.parse();
+    if (problem != nullptr) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+      throw InvalidPluralRuleException{std::string{rule.data(), rule.size()}, problem};
+#else
+      return false;
+#endif
+    }
+
+    rules_[static_cast<std::size_t>(category)] = std::move(compiled);
+    for (std::size_t n = 0; n < kTableSize; ++n) {
+      table_[n] = evaluate(n);
+    }
+    return true;
+  }
+
+  /** Returns the category of the given (non-negative) count. */
+  PluralCategory select(int count) const {
+    Expects(count >= 0);
+    const auto n = static_cast<std::uint64_t>(count);
+    return (n < kTableSize) ? table_[n] : evaluate(n);
+  }
+
+  /** Same as select(), but always evaluates the compiled rules. */
+  PluralCategory evaluate(std::uint64_t n) const {
+    for (std::size_t i = 0; i + 1 < kNumPluralCategories; ++i) {
+      if (rules_[i].matches(n)) {
+        return static_cast<PluralCategory>(i);
+      }
+    }
+    return PluralCategory::kOther;
+  }
+
+private:
+  /** Returns true if word is one of the space separated words in list. */
+  static bool hasWord(basic_string_view<char> list, basic_string_view<char> word) {
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+      const std::size_t end = std::min(list.find(' ', begin), list.size());
+      if (list.substr(begin, end - begin) == word) {
+        return true;
+      }
+      begin = end + 1;
+    }
+    return false;
+  }
+
+  std::array<internal::CompiledPluralRule, kNumPluralCategories - 1> rules_;
+  std::array<PluralCategory, kTableSize> table_;
+};
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_PLURAL_RULES_HPP
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/plural_rules.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace {
+
+using simple_tr8n::PluralCategory;
+
+constexpr char kMsgType[] = "your_project.messages.num_files";
+constexpr std::size_t kNumCounts = 1024;  // Power of 2, to cycle through cheaply.
+
+/** Realistic counts: mostly small, with the occasional large one. */
+std::vector<int> makeCounts() {
+  std::mt19937 random{42};
+  std::geometric_distribution<int> small{0.1};
+  std::uniform_int_distribution<int> large{0, 1000000};
+
+  std::vector<int> counts;
+  for (std::size_t i = 0; i < kNumCounts; ++i) {
+    counts.push_back((i % 16 == 0) ? large(random) : small(random));
+  }
+  return counts;
+}
+
+// Baseline: the minimum count case list, scanned backwards for every count.
+void BM_SelectCountCase(benchmark::State& state) {
+  const auto numCases = static_cast<int>(state.range(0));
+  std::vector<simple_tr8n::PluralCase<char>> cases;
+  for (int count = 0; count < numCases; ++count) {
+    cases.emplace_back(count, "Case " + std::to_string(count));
+  }
+  const simple_tr8n::MsgConfig<char> config{std::move(cases)};
+  const auto counts = makeCounts();
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(config.pluralCase(kMsgType, counts[i]));
+    i = (i + 1) & (kNumCounts - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SelectCountCase)->RangeMultiplier(2)->Range(1, 8);
+
+// Category cases of a Russian message, selected by compiled CLDR rules.
+void BM_SelectCategoryCase(benchmark::State& state) {
+  const simple_tr8n::MsgConfig<char> config{{
+      {0, "no files"},
+      {PluralCategory::kOne, "one"},
+      {PluralCategory::kFew, "few"},
+      {PluralCategory::kMany, "many"},
+      {PluralCategory::kOther, "other"},
+  }};
+  const auto rules = simple_tr8n::PluralRules::forLanguage("ru");
+  const auto counts = makeCounts();
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(config.pluralCase(kMsgType, counts[i], rules));
+    i = (i + 1) & (kNumCounts - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SelectCategoryCase);
+
+// Just the category, which is a table lookup for small counts.
+void BM_SelectCategory(benchmark::State& state, const char* language) {
+  const auto rules = simple_tr8n::PluralRules::forLanguage(language);
+  const auto counts = makeCounts();
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rules.select(counts[i]));
+    i = (i + 1) & (kNumCounts - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_SelectCategory, en, "en");
+BENCHMARK_CAPTURE(BM_SelectCategory, ru, "ru");
+BENCHMARK_CAPTURE(BM_SelectCategory, ar, "ar");
+
+// Same as BM_SelectCategory, but always evaluating the compiled rules.
+void BM_EvaluateCategory(benchmark::State& state, const char* language) {
+  const auto rules = simple_tr8n::PluralRules::forLanguage(language);
+  const auto counts = makeCounts();
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rules.evaluate(static_cast<std::uint64_t>(counts[i])));
+    i = (i + 1) & (kNumCounts - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_EvaluateCategory, en, "en");
+BENCHMARK_CAPTURE(BM_EvaluateCategory, ru, "ru");
+BENCHMARK_CAPTURE(BM_EvaluateCategory, ar, "ar");
+
+}  // namespace
@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/plural_rules.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  #include "simple_tr8n/exceptions.hpp"
+#endif
+
+namespace test_msgs {
+
+constexpr char kFileCount[] = "test.file_count";
+constexpr char kBookCount[] = "test.book_count";
+
+}  // namespace test_msgs
+
+namespace {
+
+using simple_tr8n::PluralCategory;
+
+/** Categories selected for counts 0 to size - 1. */
+std::vector<PluralCategory> categories(const simple_tr8n::PluralRules& rules, int size) {
+  std::vector<PluralCategory> result;
+  for (int count = 0; count < size; ++count) {
+    result.push_back(rules.select(count));
+  }
+  return result;
+}
+
+}  // namespace
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::StrEq;
+
+TEST(PluralRulesTest, ShouldNameCategories) {
+  EXPECT_THAT(simple_tr8n::pluralCategoryName(PluralCategory::kFew), StrEq("few"));
+
+  PluralCategory category = PluralCategory::kOther;
+  EXPECT_TRUE(simple_tr8n::parsePluralCategory("many", category));
+  EXPECT_THAT(category, Eq(PluralCategory::kMany));
+  EXPECT_FALSE(simple_tr8n::parsePluralCategory("several", category));
+  EXPECT_THAT(category, Eq(PluralCategory::kMany));
+}
+
+TEST(PluralRulesTest, ShouldSelectBuiltInLanguageCategories) {
+  constexpr auto kZero = PluralCategory::kZero;
+  constexpr auto kOne = PluralCategory::kOne;
+  constexpr auto kTwo = PluralCategory::kTwo;
+  constexpr auto kFew = PluralCategory::kFew;
+  constexpr auto kMany = PluralCategory::kMany;
+  constexpr auto kOther = PluralCategory::kOther;
+
+  EXPECT_THAT(categories(simple_tr8n::PluralRules{}, 3), ElementsAre(kOther, kOther, kOther));
+  EXPECT_THAT(
+      categories(simple_tr8n::PluralRules::forLanguage("ja"), 3),
+      ElementsAre(kOther, kOther, kOther));
+  EXPECT_THAT(
+      categories(simple_tr8n::PluralRules::forLanguage("en-US"), 3),
+      ElementsAre(kOther, kOne, kOther));
+  EXPECT_THAT(
+      categories(simple_tr8n::PluralRules::forLanguage("FR"), 3), ElementsAre(kOne, kOne, kOther));
+
+  const auto ru = simple_tr8n::PluralRules::forLanguage("ru_RU");
+  EXPECT_THAT(categories(ru, 6), ElementsAre(kMany, kOne, kFew, kFew, kFew, kMany));
+  EXPECT_THAT(ru.select(11), Eq(kMany));
+  EXPECT_THAT(ru.select(12), Eq(kMany));
+  EXPECT_THAT(ru.select(21), Eq(kOne));
+  EXPECT_THAT(ru.select(22), Eq(kFew));
+  EXPECT_THAT(ru.select(111), Eq(kMany));
+  EXPECT_THAT(ru.select(1001), Eq(kOne));
+  EXPECT_THAT(ru.select(1012), Eq(kMany));
+
+  const auto ar = simple_tr8n::PluralRules::forLanguage("ar");
+  EXPECT_THAT(categories(ar, 4), ElementsAre(kZero, kOne, kTwo, kFew));
+  EXPECT_THAT(ar.select(11), Eq(kMany));
+  EXPECT_THAT(ar.select(100), Eq(kOther));
+  EXPECT_THAT(ar.select(103), Eq(kFew));
+  EXPECT_THAT(ar.select(1099), Eq(kMany));
+
+  const auto pl = simple_tr8n::PluralRules::forLanguage("pl");
+  EXPECT_THAT(categories(pl, 6), ElementsAre(kMany, kOne, kFew, kFew, kFew, kMany));
+  EXPECT_THAT(pl.select(21), Eq(kMany));
+  EXPECT_THAT(pl.select(1022), Eq(kFew));
+
+  const auto es = simple_tr8n::PluralRules::forLanguage("es");
+  EXPECT_THAT(es.select(1), Eq(kOne));
+  EXPECT_THAT(es.select(1000), Eq(kOther));
+  EXPECT_THAT(es.select(1000000), Eq(kMany));
+  EXPECT_THAT(es.select(2000001), Eq(kOther));
+}
+
+TEST(PluralRulesTest, ShouldMatchCompiledRulesForSmallCounts) {
+  for (const char* language : {"en", "fr", "pt", "ru", "pl", "cs", "lt", "ro", "he", "ar", "ga"}) {
+    const auto rules = simple_tr8n::PluralRules::forLanguage(language);
+    for (int count = 0; count < 1000; ++count) {
+      ASSERT_THAT(rules.select(count), Eq(rules.evaluate(static_cast<std::uint64_t>(count))))
+          << language << " " << count;
+    }
+  }
+}
+
+TEST(PluralRulesTest, ShouldCompileCustomRules) {
+  simple_tr8n::PluralRules rules;
+  EXPECT_TRUE(
+      rules.setRule(PluralCategory::kOne, "n mod 10 = 1 and n % 100 != 11 @integer 1, 21"));
+  EXPECT_TRUE(rules.setRule(PluralCategory::kFew, "n = 2..4,7 or v != 0"));
+  EXPECT_TRUE(rules.setRule(PluralCategory::kMany, "n % 1000 = 500..599 or f = 0"));
+
+  EXPECT_THAT(rules.select(1), Eq(PluralCategory::kOne));
+  EXPECT_THAT(rules.select(11), Eq(PluralCategory::kMany));  // f = 0 always holds.
+  EXPECT_THAT(rules.select(7), Eq(PluralCategory::kFew));
+  EXPECT_THAT(rules.select(5), Eq(PluralCategory::kMany));
+
+  // Replacing a rule.
+  EXPECT_TRUE(rules.setRule(PluralCategory::kMany, "n % 1000 = 500..599"));
+  EXPECT_THAT(rules.select(5), Eq(PluralCategory::kOther));
+  EXPECT_THAT(rules.select(1505), Eq(PluralCategory::kMany));
+}
+
+TEST(PluralRulesTest, ShouldSelectCategoryCases) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(
+      test_msgs::kFileCount,
+      {
+          {PluralCategory::kOther, "%{num} files"},
+          {0, "no files"},
+          {PluralCategory::kOne, "%{num} file"},
+          {PluralCategory::kFew, "%{num} files (few)"},
+      });
+  configs->add(test_msgs::kBookCount, {{1, "a book"}, {2, "%{num} books"}});
+  configs->setPluralRules(simple_tr8n::PluralRules::forLanguage("ru"));
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+
+  const auto translate = [&translator](const char* msgType, int count) {
+    return translator.translatePlural(msgType, count, {{"num", std::to_string(count)}});
+  };
+  EXPECT_THAT(translate(test_msgs::kFileCount, 0), Eq("no files"));
+  EXPECT_THAT(translate(test_msgs::kFileCount, 1), Eq("1 file"));
+  EXPECT_THAT(translate(test_msgs::kFileCount, 3), Eq("3 files (few)"));
+  EXPECT_THAT(translate(test_msgs::kFileCount, 5), Eq("5 files"));
+  EXPECT_THAT(translate(test_msgs::kFileCount, 101), Eq("101 file"));
+
+  // Count cases only: still selected by minimum count.
+  EXPECT_THAT(translate(test_msgs::kBookCount, 1), Eq("a book"));
+  EXPECT_THAT(translate(test_msgs::kBookCount, 21), Eq("21 books"));
+}
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(PluralRulesTest, ShouldHandleErrors) {
+  simple_tr8n::PluralRules rules;
+  EXPECT_THROW(
+      rules.setRule(PluralCategory::kOne, ""), simple_tr8n::InvalidPluralRuleException);
+  EXPECT_THROW(
+      rules.setRule(PluralCategory::kOne, "x = 1"), simple_tr8n::InvalidPluralRuleException);
+  EXPECT_THROW(
+      rules.setRule(PluralCategory::kOne, "n % 0 = 1"), simple_tr8n::InvalidPluralRuleException);
+  EXPECT_THROW(
+      rules.setRule(PluralCategory::kOne, "n = 3..2"), simple_tr8n::InvalidPluralRuleException);
+  EXPECT_THROW(
+      rules.setRule(PluralCategory::kOne, "n = 1 and"), simple_tr8n::InvalidPluralRuleException);
+  EXPECT_THROW(
+      rules.setRule(PluralCategory::kOne, "n is 1"), simple_tr8n::InvalidPluralRuleException);
+  EXPECT_THAT(rules.select(1), Eq(PluralCategory::kOther));
+
+  // No case for the selected category, and no kOther case to fall back on.
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kFileCount, {{PluralCategory::kOne, "a file"}});
+  configs->setPluralRules(simple_tr8n::PluralRules::forLanguage("en"));
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+  EXPECT_THAT(translator.translatePlural(test_msgs::kFileCount, 1, {}), Eq("a file"));
+  EXPECT_THROW(
+      translator.translatePlural(test_msgs::kFileCount, 2, {}),
+      simple_tr8n::InvalidArgsException<char>);
+}
+
+#else  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST(PluralRulesTest, ShouldHandleErrors) {
+  simple_tr8n::PluralRules rules;
+  EXPECT_FALSE(rules.setRule(PluralCategory::kOne, ""));
+  EXPECT_FALSE(rules.setRule(PluralCategory::kOne, "x = 1"));
+  EXPECT_FALSE(rules.setRule(PluralCategory::kOne, "n % 0 = 1"));
+  EXPECT_FALSE(rules.setRule(PluralCategory::kOne, "n = 3..2"));
+  EXPECT_FALSE(rules.setRule(PluralCategory::kOne, "n = 1 and"));
+  EXPECT_FALSE(rules.setRule(PluralCategory::kOne, "n is 1"));
+  EXPECT_THAT(rules.select(1), Eq(PluralCategory::kOther));
+
+  // No case for the selected category, and no kOther case to fall back on.
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kFileCount, {{PluralCategory::kOne, "a file"}});
+  configs->setPluralRules(simple_tr8n::PluralRules::forLanguage("en"));
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+  EXPECT_THAT(translator.translatePlural(test_msgs::kFileCount, 1, {}), Eq("a file"));
+  EXPECT_THAT(translator.translatePlural(test_msgs::kFileCount, 2, {}), Eq(""));
+}
+
+#endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_RELOADABLE_TRANSLATOR_HPP
+#define SIMPLE_TR8N_RELOADABLE_TRANSLATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/simple_translator.hpp"
+#include "simple_tr8n/string_view.hpp"
+#include "simple_tr8n/translator.hpp"
+
+namespace simple_tr8n {
+
+/**
+ * Translator whose translations can be replaced while it is in use, e.g. to
+ * pick up translation fixes without restarting.
+ *
+ * Each call translates with a snapshot of the current catalog, taken with an
+ * atomic shared_ptr load. reload() builds and freezes the new catalog before
+ * atomically publishing it, so it never blocks or waits for concurrent
+ * translate calls. Calls already in progress finish with the catalog they
+ * started with, which is destroyed once the last of them finishes.
+ */
+template<typename CharT>
+class ReloadableTranslator : public Translator<CharT> {
+public:
+  using string_type = typename Translator<CharT>::string_type;
+
+  using Translator<CharT>::translate;
+  using Translator<CharT>::translatePlural;
+
+  explicit ReloadableTranslator(std::unique_ptr<MsgConfigs<CharT>> configs)
+      : current_{std::make_shared<const SimpleTranslator<CharT>>(std::move(configs))} {}
+
+  ~ReloadableTranslator() override = default;
+
+  ReloadableTranslator(const ReloadableTranslator&) = delete;
+  ReloadableTranslator& operator=(const ReloadableTranslator&) = delete;
+
+  ReloadableTranslator(ReloadableTranslator&&) = delete;
+  ReloadableTranslator& operator=(ReloadableTranslator&&) = delete;
+
+  /**
+   * Replaces all translations with the given configs (freezing them first, on
+   * the calling thread). Safe to call concurrently with any other member.
+   */
+  void reload(std::unique_ptr<MsgConfigs<CharT>> configs) {
+    std::shared_ptr<const SimpleTranslator<CharT>> next =
+        std::make_shared<const SimpleTranslator<CharT>>(std::move(configs));
+    std::atomic_store_explicit(&current_, std::move(next), std::memory_order_release);
+  }
+
+  /**
+   * Returns the current translations, which stay unchanged (and valid) after
+   * any later reload(). Use this to translate several related messages from
+   * the same catalog.
+   */
+  std::shared_ptr<const SimpleTranslator<CharT>> snapshot() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+
+  string_type translate(basic_string_view<CharT> msgType) const override {
+    return snapshot()->translate(msgType);
+  }
+
+  string_type translate(
+      basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const override {
+    return snapshot()->translate(msgType, args);
+  }
+
+  string_type translatePlural(
+      basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const override {
+    return snapshot()->translatePlural(msgType, pluralCount, args);
+  }
+
+  /**
+   * Resolves against the current catalog. Handles stay usable after reloads:
+   * if the message types changed, they fall back to lookup by message type.
+   */
+  MsgId<CharT> resolve(basic_string_view<CharT> msgType) const override {
+    return snapshot()->resolve(msgType);
+  }
+
+  string_type translate(const MsgId<CharT>& msgId) const override {
+    return snapshot()->translate(msgId);
+  }
+
+  string_type translate(const MsgId<CharT>& msgId, const TransArgs<CharT>& args) const override {
+    return snapshot()->translate(msgId, args);
+  }
+
+  string_type translatePlural(
+      const MsgId<CharT>& msgId, int pluralCount, const TransArgs<CharT>& args) const override {
+    return snapshot()->translatePlural(msgId, pluralCount, args);
+  }
+
+  void translateTo(string_type& out, basic_string_view<CharT> msgType) const override {
+    snapshot()->translateTo(out, msgType);
+  }
+
+  void translateTo(
+      string_type& out, basic_string_view<CharT> msgType,
+      const TransArgs<CharT>& args) const override {
+    snapshot()->translateTo(out, msgType, args);
+  }
+
+  void translatePluralTo(
+      string_type& out, basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const override {
+    snapshot()->translatePluralTo(out, msgType, pluralCount, args);
+  }
+
+  /** Translates the whole batch with the same snapshot. */
+  void translateBatch(
+      gsl::span<const TransRequest<CharT>> requests, string_type& out,
+      std::vector<std::size_t>& offsets) const override {
+    snapshot()->translateBatch(requests, out, offsets);
+  }
+
+protected:
+  string_type translatePositional(
+      basic_string_view<CharT> msgType, int pluralCount, const basic_string_view<CharT>* argKeys,
+      std::uint64_t argKeysHash, const basic_string_view<CharT>* values,
+      std::size_t numArgs) const override {
+    return snapshot()->translatePositional(
+        msgType, pluralCount, argKeys, argKeysHash, values, numArgs);
+  }
+
+private:
+  // Note: Only ever accessed through std::atomic_load/std::atomic_store.
+  std::shared_ptr<const SimpleTranslator<CharT>> current_;
+};
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_RELOADABLE_TRANSLATOR_HPP
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "simple_tr8n/reloadable_translator.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace {
+
+constexpr char kHelloName[] = "your_project.messages.hello_name";
+constexpr std::size_t kNumMsgs = 1000;
+
+std::unique_ptr<simple_tr8n::MsgConfigs<char>> makeConfigs(int version) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  for (std::size_t i = 0; i < kNumMsgs; ++i) {
+    configs->add(
+        "your_project.messages.msg_" + std::to_string(i), "A message with a %{arg} argument");
+  }
+  configs->add(kHelloName, "v" + std::to_string(version) + ": hello, %{personName}!");
+  return configs;
+}
+
+// Shared by all benchmark threads (set up by thread 0 before its loop starts,
+// which happens before any thread's loop starts).
+std::unique_ptr<simple_tr8n::SimpleTranslator<char>> simpleTranslator;
+std::unique_ptr<simple_tr8n::ReloadableTranslator<char>> reloadableTranslator;
+std::atomic<bool> stopReloading{false};
+std::atomic<int> numReloads{0};
+
+template<typename TranslatorPtr>
+void readerLoop(benchmark::State& state, const TranslatorPtr& translator) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(translator->translate(kHelloName, {{"personName", "Alice"}}));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Baseline: a SimpleTranslator that never changes.
+void BM_SimpleTranslate(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    simpleTranslator = std::make_unique<simple_tr8n::SimpleTranslator<char>>(makeConfigs(0));
+  }
+  readerLoop(state, simpleTranslator);
+}
+BENCHMARK(BM_SimpleTranslate)->ThreadRange(1, 8)->UseRealTime();
+
+// A ReloadableTranslator with no reloads.
+void BM_ReloadableTranslate(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    reloadableTranslator =
+        std::make_unique<simple_tr8n::ReloadableTranslator<char>>(makeConfigs(0));
+  }
+  readerLoop(state, reloadableTranslator);
+}
+BENCHMARK(BM_ReloadableTranslate)->ThreadRange(1, 8)->UseRealTime();
+
+// Reader throughput while a separate writer thread continuously builds and
+// publishes new catalogs.
+void BM_ReloadableTranslateDuringReloads(benchmark::State& state) {
+  std::thread writer;
+  if (state.thread_index() == 0) {
+    reloadableTranslator =
+        std::make_unique<simple_tr8n::ReloadableTranslator<char>>(makeConfigs(0));
+    stopReloading = false;
+    numReloads = 0;
+    writer = std::thread{[]() {
+      while (!stopReloading) {
+        reloadableTranslator->reload(makeConfigs(++numReloads));
+      }
+    }};
+  }
+
+  readerLoop(state, reloadableTranslator);
+
+  if (state.thread_index() == 0) {
+    stopReloading = true;
+    writer.join();
+    state.counters["reloads"] = benchmark::Counter(numReloads, benchmark::Counter::kIsRate);
+  }
+}
+BENCHMARK(BM_ReloadableTranslateDuringReloads)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simple_tr8n/reloadable_translator.hpp"
+#include "simple_tr8n/simple_translator.hpp"
+
+namespace test_msgs {
+
+constexpr char kVersion[] = "test.version";
+constexpr char kVersionArg[] = "test.version_arg";
+
+constexpr auto kHelloName = simple_tr8n::makeMsgDescriptor("test.hello_name", "personName");
+
+}  // namespace test_msgs
+
+namespace {
+
+// Catalog where every message includes the given version number.
+std::unique_ptr<simple_tr8n::MsgConfigs<char>> versionConfigs(int version) {
+  const std::string prefix = "v" + std::to_string(version);
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kVersion, prefix)
+      .add(test_msgs::kVersionArg, prefix + " %{arg}")
+      .add(test_msgs::kHelloName, prefix + " hello, %{personName}!");
+  return configs;
+}
+
+int parseVersion(const std::string& translated) {
+  return std::stoi(translated.substr(1));
+}
+
+}  // namespace
+
+using ::testing::Eq;
+
+TEST(ReloadableTranslatorTest, ShouldTranslateLatestCatalog) {
+  simple_tr8n::ReloadableTranslator<char> translator{versionConfigs(1)};
+  const simple_tr8n::Translator<char>& api = translator;
+  const auto msgId = api.resolve(test_msgs::kVersionArg);
+
+  EXPECT_THAT(api.translate(test_msgs::kVersion), Eq("v1"));
+  EXPECT_THAT(api.translate(msgId, {{"arg", "x"}}), Eq("v1 x"));
+  EXPECT_THAT(api.translate(test_msgs::kHelloName, "Amy"), Eq("v1 hello, Amy!"));
+
+  translator.reload(versionConfigs(2));
+  EXPECT_THAT(api.translate(test_msgs::kVersion), Eq("v2"));
+  EXPECT_THAT(api.translate(msgId, {{"arg", "x"}}), Eq("v2 x"));
+  EXPECT_THAT(api.translate(test_msgs::kHelloName, "Amy"), Eq("v2 hello, Amy!"));
+
+  std::string out = "> ";
+  api.translateTo(out, test_msgs::kVersionArg, {{"arg", "y"}});
+  EXPECT_THAT(out, Eq("> v2 y"));
+}
+
+TEST(ReloadableTranslatorTest, ShouldKeepSnapshotsAcrossReloads) {
+  simple_tr8n::ReloadableTranslator<char> translator{versionConfigs(1)};
+  const auto snapshot = translator.snapshot();
+
+  translator.reload(versionConfigs(2));
+  EXPECT_THAT(snapshot->translate(test_msgs::kVersion), Eq("v1"));
+  EXPECT_THAT(translator.translate(test_msgs::kVersion), Eq("v2"));
+}
+
+TEST(ReloadableTranslatorTest, ShouldTranslateConsistentlyDuringReloads) {
+  constexpr int kNumReaders = 4;
+  constexpr int kNumReloads = 200;
+
+  simple_tr8n::ReloadableTranslator<char> translator{versionConfigs(0)};
+  std::atomic<bool> done{false};
+  std::atomic<int> numErrors{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back([&]() {
+      int lastVersion = 0;
+      while (!done) {
+        // Messages from one snapshot always come from the same catalog.
+        const auto snapshot = translator.snapshot();
+        const auto version = snapshot->translate(test_msgs::kVersion);
+        if (snapshot->translate(test_msgs::kVersionArg, {{"arg", "x"}}) != version + " x") {
+          ++numErrors;
+        }
+
+        // Versions seen never go backwards.
+        const int currentVersion = parseVersion(translator.translate(test_msgs::kHelloName, "A"));
+        if (currentVersion < lastVersion || currentVersion > kNumReloads) {
+          ++numErrors;
+        }
+        lastVersion = currentVersion;
+      }
+    });
+  }
+
+  for (int version = 1; version <= kNumReloads; ++version) {
+    translator.reload(versionConfigs(version));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_THAT(numErrors.load(), Eq(0));
+  EXPECT_THAT(translator.translate(test_msgs::kVersion), Eq("v200"));
+}
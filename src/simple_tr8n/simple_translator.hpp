@@ -5,17 +5,27 @@
 #ifndef SIMPLE_TR8N_SIMPLE_TRANSLATOR_HPP
 #define SIMPLE_TR8N_SIMPLE_TRANSLATOR_HPP
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <map>
 #include <memory>
-#include <regex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <gsl/gsl>
 
+#include "simple_tr8n/catalog_format.hpp"
+#include "simple_tr8n/msg_template.hpp"
+#include "simple_tr8n/perfect_hash.hpp"
+#include "simple_tr8n/plural_rules.hpp"
+#include "simple_tr8n/string_pool.hpp"
 #include "simple_tr8n/string_view.hpp"
 #include "simple_tr8n/translator.hpp"
 
@@ -23,36 +33,72 @@
   #include "simple_tr8n/exceptions.hpp"
 #endif
 
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  #include "simple_tr8n/metrics.hpp"
+#endif
+
 namespace simple_tr8n {
 namespace internal {
 
-/** Count value used to represent a non-plural case. */
-constexpr int kNoCount = -1;
+/**
+ * Reserves room to append size more characters to a sink with size(),
+ * capacity() and reserve() members (like std::basic_string). Grows
+ * geometrically, so that appending many translations stays amortized O(1).
+ */
+template<typename Sink>
+auto reserveMore(Sink& sink, std::size_t size, int)
+    -> decltype(sink.reserve(sink.size() + sink.capacity()), void()) {
+  const std::size_t needed = sink.size() + size;
+  if (needed > sink.capacity()) {
+    sink.reserve(std::max<std::size_t>(needed, 2 * sink.capacity()));
+  }
+}
 
-template<typename CharT>
-std::basic_regex<CharT> argPattern();
+/** Fallback for sinks that can't reserve space. */
+template<typename Sink>
+void reserveMore(Sink&, std::size_t, long) {}
 
-template<>
-inline std::basic_regex<char> argPattern() {
-  return std::basic_regex<char>("%\\{(.*?)\\}");
+/** Returns the size of a sink with a size() member, else 0. */
+template<typename Sink>
+auto sinkSize(const Sink& sink, int) -> decltype(std::size_t{sink.size()}) {
+  return sink.size();
 }
 
-template<>
-inline std::basic_regex<wchar_t> argPattern() {
-  return std::basic_regex<wchar_t>(L"%\\{(.*?)\\}");
+/** Fallback for sinks without size(). */
+template<typename Sink>
+std::size_t sinkSize(const Sink&, long) {
+  return 0;
 }
 
-// TODO: Provide specializations for additional char types (int16_t, int32_t),
-// if needed.
+/** Shrinks a sink with size() and resize() members (like std::basic_string) back to size. */
+template<typename Sink>
+auto truncateTo(Sink& sink, std::size_t size, int)
+    -> decltype(sink.size(), sink.resize(size), void()) {
+  sink.resize(size);
+}
 
-template<typename CharT>
-const std::basic_string<CharT>& emptyStr() {
-  static std::basic_string<CharT> empty{};
-  return empty;
+/** Fallback for append-only sinks, which keep what was appended. */
+template<typename Sink>
+void truncateTo(Sink&, std::size_t, long) {}
+
+/**
+ * PluralCase count encoding a plural category case: -2 for kZero down to -7
+ * for kOther (all below kNoCount, which marks non-plural messages).
+ */
+inline int categoryCount(PluralCategory category) {
+  return kNoCount - 1 - static_cast<int>(category);
+}
+
+/** Returns true if count encodes a plural category (see categoryCount()). */
+inline bool isCategoryCount(int count) {
+  return (count < kNoCount) && (count >= categoryCount(PluralCategory::kOther));
 }
 
 }  // namespace internal
 
+template<typename CharT>
+class MsgConfigs;
+
 /** User-visible message value configured for a particular plural count case. */
 template<typename CharT>
 class PluralCase {
@@ -62,20 +108,118 @@ public:
    * Configures plural case with the given minimum count. The highest matching
    * (<= actual count) case will be selected.
    */
-  PluralCase(int count, std::basic_string<CharT> msg) : count_{count}, msg_{std::move(msg)} {}
+  PluralCase(int count, std::basic_string<CharT> msg)
+      : count_{count}, owned_{std::make_unique<Owned>(std::move(msg))} {
+    viewOwned();
+  }
+
+  // Note: Intentionally allowing implicit type conversion syntax.
+  /**
+   * Configures plural case selected for counts in the given CLDR plural
+   * category, as determined by the PluralRules of the locale's MsgConfigs.
+   */
+  PluralCase(PluralCategory category, std::basic_string<CharT> msg)
+      : PluralCase{internal::categoryCount(category), std::move(msg)} {}
+
+  ~PluralCase() = default;
+
+  PluralCase(const PluralCase& other)
+      : count_{other.count_},
+        numSegments_{other.numSegments_},
+        msg_{other.msg_},
+        segments_{other.segments_} {
+    if (other.owned_ != nullptr) {
+      owned_ = std::make_unique<Owned>(*other.owned_);
+      viewOwned();
+    }
+  }
 
-  /** Minimum count for which this case will be selected. */
+  PluralCase& operator=(const PluralCase& other) {
+    PluralCase copy{other};
+    return *this = std::move(copy);
+  }
+
+  // Note: Owned text lives on the heap, so moving doesn't invalidate views of it.
+  PluralCase(PluralCase&&) = default;
+  PluralCase& operator=(PluralCase&&) = default;
+
+  /**
+   * Minimum count for which this case will be selected (or the exact count,
+   * in messages that also have category cases). Negative for category cases.
+   */
   int count() const { return count_; }
 
+  /** Returns true if this case was configured with a PluralCategory. */
+  bool hasCategory() const { return internal::isCategoryCount(count_); }
+
+  /** Plural category for which this case will be selected. */
+  PluralCategory category() const {
+    Expects(hasCategory());
+    return static_cast<PluralCategory>(internal::kNoCount - 1 - count_);
+  }
+
   /**
    * User-visible message, possibly containing %{argKey} tokens for
    * interpolation.
    */
-  const std::basic_string<CharT>& msg() const { return msg_; }
+  basic_string_view<CharT> msg() const { return msg_; }
+
+  /** Parsed literal and argument segments of msg(), in output order. */
+  gsl::span<const internal::MsgSegment> segments() const {
+    return gsl::span<const internal::MsgSegment>{segments_, numSegments_};
+  }
+
+  /**
+   * Binds argument segments to their positions within argKeys. Returns the
+   * first argument segment not found in argKeys, or nullptr if all were found.
+   */
+  const internal::MsgSegment* bindArgs(
+      const basic_string_view<CharT>* argKeys, std::size_t numArgKeys) {
+    Expects(owned_ != nullptr);
+    return internal::bindArgSlots<CharT>(msg_, owned_->segments, argKeys, numArgKeys);
+  }
+
+  /**
+   * Binds argument segments to slots shared by equal argKeys, appending new
+   * argKeys to slotKeys (see internal::assignArgSlots()).
+   */
+  void assignArgSlots(std::vector<basic_string_view<CharT>>& slotKeys) {
+    Expects(owned_ != nullptr);
+    internal::assignArgSlots<CharT>(msg_, owned_->segments, slotKeys);
+  }
 
 private:
+  friend class MsgConfigs<CharT>;
+
+  // Message text and segments, while not yet packed into a frozen MsgConfigs.
+  struct Owned {
+    explicit Owned(std::basic_string<CharT> msg)
+        : msg{std::move(msg)}, segments{internal::parseMsgSegments<CharT>(this->msg)} {}
+
+    std::basic_string<CharT> msg;
+    internal::MsgSegments segments;
+  };
+
+  /** Views message text and segments packed into a frozen MsgConfigs. */
+  PluralCase(
+      int count, basic_string_view<CharT> msg, const internal::MsgSegment* segments,
+      std::size_t numSegments)
+      : count_{count},
+        numSegments_{gsl::narrow_cast<std::uint32_t>(numSegments)},
+        msg_{msg},
+        segments_{segments} {}
+
+  void viewOwned() {
+    msg_ = owned_->msg;
+    segments_ = owned_->segments.data();
+    numSegments_ = gsl::narrow_cast<std::uint32_t>(owned_->segments.size());
+  }
+
   int count_;
-  std::basic_string<CharT> msg_;
+  std::uint32_t numSegments_ = 0;
+  basic_string_view<CharT> msg_;
+  const internal::MsgSegment* segments_ = nullptr;
+  std::unique_ptr<Owned> owned_;  // Null once packed.
 };
 
 /**
@@ -88,16 +232,30 @@ public:
   // Note: Intentionally allowing implicit type conversion syntax.
   /** Configures a message case without any plurals. */
   MsgConfig(basic_string_view<CharT> msg) {
-    cases_.emplace_back(internal::kNoCount, std::basic_string<CharT>{msg});
+    ownedCases_.emplace_back(internal::kNoCount, std::basic_string<CharT>{msg});
+    viewOwned();
   }
 
   // Note: Intentionally allowing implicit type conversion syntax.
   /**
    * Configures a message with (potentially multiple) plural cases. Input cases
    * must be in ascending count order.
+   *
+   * Cases may instead (or also) be configured by PluralCategory, each at most
+   * once. Then counts are mapped to categories by the locale's PluralRules,
+   * and count cases only match their exact count (taking precedence over the
+   * category, e.g. for a special "no files" message). Counts in a category
+   * without a case use the kOther case.
    */
-  MsgConfig(std::initializer_list<PluralCase<CharT>> cases) : cases_{std::move(cases)} {
-    Expects(cases_.size() >= 1);
+  MsgConfig(std::initializer_list<PluralCase<CharT>> cases) : ownedCases_{std::move(cases)} {
+    Expects(ownedCases_.size() >= 1);
+    viewOwned();
+  }
+
+  /** Same as above, for cases only known at runtime (e.g. loaded from a file). */
+  explicit MsgConfig(std::vector<PluralCase<CharT>> cases) : ownedCases_{std::move(cases)} {
+    Expects(ownedCases_.size() >= 1);
+    viewOwned();
   }
 
   ~MsgConfig() = default;
@@ -105,45 +263,212 @@ public:
   MsgConfig(const MsgConfig&) = delete;
   MsgConfig& operator=(const MsgConfig&) = delete;
 
+  // Note: Moving a vector keeps its elements in place, so cases_ stays valid.
   MsgConfig(MsgConfig&&) = default;
   MsgConfig& operator=(MsgConfig&&) = default;
 
+  /**
+   * Binds argument segments of all cases to their positions within argKeys
+   * (the argument keys of a MsgDescriptor, whose argKeysHash() is given).
+   * Returns the first argument key not found in argKeys, or an empty view if
+   * all were found.
+   */
+  basic_string_view<CharT> bindArgs(
+      const basic_string_view<CharT>* argKeys, std::size_t numArgKeys,
+      std::uint64_t argKeysHash) {
+    Expects(!ownedCases_.empty());
+    basic_string_view<CharT> unboundKey;
+    for (auto& msgCase : ownedCases_) {
+      const internal::MsgSegment* unbound = msgCase.bindArgs(argKeys, numArgKeys);
+      if (unbound != nullptr && unboundKey.empty()) {
+        unboundKey = internal::segmentText<CharT>(msgCase.msg(), *unbound);
+      }
+    }
+
+    numBoundArgs_ = gsl::narrow_cast<int>(numArgKeys);
+    boundArgsHash_ = argKeysHash;
+    numSlots_ = numArgKeys;
+    return unboundKey;
+  }
+
+  /**
+   * Number of distinct argument slots used by this message's cases. Argument
+   * segments with equal argKeys share a slot, so each argument only needs to
+   * be looked up once per translation.
+   */
+  std::size_t numSlots() const { return numSlots_; }
+
+  /**
+   * Number of MsgDescriptor argument keys this message was bound to, or -1 if
+   * it was added without a MsgDescriptor.
+   */
+  int numBoundArgs() const { return numBoundArgs_; }
+
+  /**
+   * Hash of the MsgDescriptor argument keys this message was bound to, in
+   * order (see internal::hashArgKeys()), or 0 if it wasn't bound. Argument
+   * slots only match a descriptor's positions if its keys hash the same.
+   */
+  std::uint64_t boundArgsHash() const { return boundArgsHash_; }
+
   /** Returns true if this message was configured with 1+ plural cases. */
   bool hasPluralCases() const {
-    return (cases_.size() >= 2) || (cases_[0].count() != internal::kNoCount);
+    return (numCases_ >= 2) || (cases_[0].count() != internal::kNoCount);
   }
 
-  /** Returns message value for the only case configured. */
-  const std::basic_string<CharT>& onlyCase() const {
+  /** Returns the only case configured. */
+  const PluralCase<CharT>& onlyCase() const {
     Expects(!hasPluralCases());
-    return cases_[0].msg();
+    return cases_[0];
+  }
+
+  /** All configured cases, count cases first (in the order configured). */
+  gsl::span<const PluralCase<CharT>> cases() const {
+    return gsl::span<const PluralCase<CharT>>{cases_, numCases_};
   }
 
-  /** Returns best matching message case value for the given plural count. */
-  const std::basic_string<CharT>& pluralCase(basic_string_view<CharT> msgType, int count) const {
+  /** Returns true if this message has any cases configured by PluralCategory. */
+  bool hasCategoryCases() const { return hasCategories_; }
+
+  /**
+   * Returns best matching case for the given plural count, or nullptr if there
+   * is none (when exceptions are disabled). Category cases are selected by
+   * the given rules.
+   */
+  const PluralCase<CharT>* pluralCase(
+      basic_string_view<CharT> msgType, int count, const PluralRules& rules) const {
+    const PluralCase<CharT>* result = findPluralCase(count, rules);
+    if (result == nullptr) {
+      // No configured plural case.
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+      throw InvalidArgsException<CharT>{msgType};
+#else
+      static_cast<void>(msgType);  // Suppress unreferenced parameter warning.
+#endif
+    }
+    return result;
+  }
+
+  /** Same as above, for messages configured with count cases only. */
+  const PluralCase<CharT>* pluralCase(basic_string_view<CharT> msgType, int count) const {
+    static const PluralRules otherOnly;
+    return pluralCase(msgType, count, otherOnly);
+  }
+
+  /** Same as pluralCase(), but returns nullptr if there is no case, whatever the build mode. */
+  const PluralCase<CharT>* findPluralCase(int count, const PluralRules& rules) const {
     Expects(count >= 0);
     Expects(hasPluralCases());
 
-    for (int i = gsl::narrow_cast<int>(cases_.size()) - 1; i >= 0; --i) {
-      if (cases_[i].count() <= count) {
-        return cases_[i].msg();
+    if (hasCategories_) {
+      // Note: Count cases sort before category cases, and there are rarely
+      // more than one or two of them.
+      for (std::uint32_t i = 0; i < numCases_ && !cases_[i].hasCategory(); ++i) {
+        if (cases_[i].count() == count) {
+          return &cases_[i];
+        }
+      }
+
+      std::uint8_t index = categoryCases_[static_cast<std::size_t>(rules.select(count))];
+      if (index == kNoCase) {
+        index = categoryCases_[static_cast<std::size_t>(PluralCategory::kOther)];
+      }
+      if (index != kNoCase) {
+        return &cases_[index];
+      }
+    } else {
+      for (int i = gsl::narrow_cast<int>(numCases_) - 1; i >= 0; --i) {
+        if (cases_[i].count() <= count) {
+          return &cases_[i];
+        }
       }
     }
 
-    // No configured plural case.
-#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
-    throw InvalidArgsException<CharT>{msgType};
-#else
-    static_cast<void>(msgType);  // Suppress unreferenced parameter warning.
-    return internal::emptyStr<CharT>();
-#endif
+    return nullptr;
   }
 
 private:
-  std::vector<PluralCase<CharT>> cases_;  // Invariant: cases_.size() >= 1.
+  friend class MsgConfigs<CharT>;
+
+  static constexpr std::uint8_t kNoCase = 0xff;
+
+  /** Views cases packed into a frozen MsgConfigs. */
+  MsgConfig(
+      const PluralCase<CharT>* cases, std::size_t numCases, std::size_t numSlots,
+      int numBoundArgs, std::uint64_t boundArgsHash)
+      : cases_{cases},
+        numCases_{gsl::narrow_cast<std::uint32_t>(numCases)},
+        numBoundArgs_{numBoundArgs},
+        boundArgsHash_{boundArgsHash},
+        numSlots_{numSlots} {
+    indexCategories();
+  }
+
+  void viewOwned() {
+    // Count cases go first, so pluralCase() can stop at the first category case.
+    std::stable_partition(ownedCases_.begin(), ownedCases_.end(), [](const auto& msgCase) {
+      return !msgCase.hasCategory();
+    });
+    cases_ = ownedCases_.data();
+    numCases_ = gsl::narrow_cast<std::uint32_t>(ownedCases_.size());
+    indexCategories();
+
+    std::vector<basic_string_view<CharT>> slotKeys;
+    for (auto& msgCase : ownedCases_) {
+      msgCase.assignArgSlots(slotKeys);
+    }
+    numSlots_ = slotKeys.size();
+  }
+
+  /** Records the index of each category case, so pluralCase() can find it directly. */
+  void indexCategories() {
+    categoryCases_.fill(kNoCase);
+    hasCategories_ = false;
+    for (std::uint32_t i = 0; i < numCases_; ++i) {
+      if (cases_[i].hasCategory()) {
+        Expects(i < kNoCase);
+        auto& index = categoryCases_[static_cast<std::size_t>(cases_[i].category())];
+        Expects(index == kNoCase);  // Each category may only be configured once.
+        index = gsl::narrow_cast<std::uint8_t>(i);
+        hasCategories_ = true;
+      }
+    }
+  }
+
+  const PluralCase<CharT>* cases_ = nullptr;  // Invariant: numCases_ >= 1.
+  std::uint32_t numCases_ = 0;
+  int numBoundArgs_ = -1;
+  std::uint64_t boundArgsHash_ = 0;
+  std::size_t numSlots_ = 0;
+  std::array<std::uint8_t, kNumPluralCategories> categoryCases_;  // Indexes, or kNoCase.
+  bool hasCategories_ = false;
+  std::vector<PluralCase<CharT>> ownedCases_;  // Empty once packed.
 };
 
-/** Complete set of translated message configurations for a given locale. */
+template<typename CharT>
+constexpr std::uint8_t MsgConfig<CharT>::kNoCase;
+
+/** How a frozen MsgConfigs stores its message types (see MsgConfigs::setKeyStorage()). */
+enum class KeyStorage : std::uint8_t {
+  kFull,           // Message type strings, compared on each lookup (default).
+  kHashOnly,       // Only a 64-bit hash of each message type.
+  kHashOnlyDebug,  // Same lookups as kHashOnly, but message types are kept for msgTypeAt().
+};
+
+/**
+ * Complete set of translated message configurations for a given locale.
+ *
+ * Messages are added to a sorted map while building. Once all have been added,
+ * freeze() converts it to an immutable table indexed by a minimal perfect hash
+ * of the message types, so that each get() costs one hash and one message type
+ * comparison (or hash comparison, with hash-only key storage; see
+ * setKeyStorage()). (SimpleTranslator freezes its MsgConfigs automatically.)
+ *
+ * Freezing also packs all message types and message texts into one contiguous
+ * buffer (and all parsed segments and plural cases into one array each), so a
+ * frozen MsgConfigs needs only a handful of heap blocks however many messages
+ * it holds.
+ */
 template<typename CharT>
 class MsgConfigs {
 public:
@@ -160,6 +485,7 @@ public:
 
   /** Adds message with just a single non-plural case. */
   MsgConfigs& add(basic_string_view<CharT> msgType, basic_string_view<CharT> msg) {
+    Expects(!frozen_);
     configs_.emplace(msgType, MsgConfig<CharT>{msg});
     return *this;
   }
@@ -167,44 +493,594 @@ public:
   /** Adds message with (potentially) multiple plural cases. */
   MsgConfigs& add(
       basic_string_view<CharT> msgType, std::initializer_list<PluralCase<CharT>> cases) {
+    Expects(!frozen_);
     configs_.emplace(msgType, MsgConfig<CharT>{std::move(cases)});
     return *this;
   }
 
+  /** Adds message with (potentially) multiple plural cases, only known at runtime. */
+  MsgConfigs& add(basic_string_view<CharT> msgType, std::vector<PluralCase<CharT>> cases) {
+    Expects(!frozen_);
+    configs_.emplace(msgType, MsgConfig<CharT>{std::move(cases)});
+    return *this;
+  }
+
+  /**
+   * Adds message with just a single non-plural case, binding its %{argKey}
+   * tokens to the descriptor's argument positions. Every argKey used must be
+   * declared by the descriptor.
+   */
+  template<std::size_t NumArgs>
+  MsgConfigs& add(const MsgDescriptor<CharT, NumArgs>& msgType, basic_string_view<CharT> msg) {
+    return addBound(
+        msgType.msgType(), MsgConfig<CharT>{msg}, msgType.argKeys().data(), NumArgs,
+        msgType.argKeysHash());
+  }
+
+  /**
+   * Adds message with (potentially) multiple plural cases, binding their
+   * %{argKey} tokens to the descriptor's argument positions. Every argKey used
+   * must be declared by the descriptor.
+   */
+  template<std::size_t NumArgs>
+  MsgConfigs& add(
+      const MsgDescriptor<CharT, NumArgs>& msgType,
+      std::initializer_list<PluralCase<CharT>> cases) {
+    return addBound(
+        msgType.msgType(), MsgConfig<CharT>{std::move(cases)}, msgType.argKeys().data(), NumArgs,
+        msgType.argKeysHash());
+  }
+
+  /**
+   * Sets how freeze() stores message types. With KeyStorage::kHashOnly, only
+   * a 64-bit hash of each is kept (which freeze() ensures is unique among the
+   * configured message types), saving their full text in every locale. A
+   * lookup then matches any message type with an equal hash, so looking up
+   * an unconfigured message type returns a wrong message with probability
+   * about size() / 2^64.
+   *
+   * Hash-only MsgConfigs can't be written with toCatalog(), and msgTypeAt()
+   * returns empty message types (e.g. in metrics), unless kHashOnlyDebug
+   * keeps them as a side table. Must be set before freezing, and not for
+   * viewed catalogs (which keep message types in their mapped data anyway).
+   */
+  MsgConfigs& setKeyStorage(KeyStorage keyStorage) {
+    Expects(!frozen_);
+    keyStorage_ = keyStorage;
+    return *this;
+  }
+
+  /** How message types are stored once frozen (see setKeyStorage()). */
+  KeyStorage keyStorage() const { return keyStorage_; }
+
+  /**
+   * Converts all added messages into an immutable perfect hash table. No more
+   * messages can be added afterwards. Does nothing if already frozen.
+   */
+  void freeze() { freeze(nullptr); }
+
+  /**
+   * Same as freeze(), but stores message types and message texts in the given
+   * pool (if not null), which this MsgConfigs then shares ownership of. Use
+   * one pool for the MsgConfigs of all locales to store strings that are
+   * identical across them only once.
+   */
+  void freeze(std::shared_ptr<StringPool<CharT>> pool) {
+    if (frozen_) {
+      return;
+    }
+    pool_ = std::move(pool);
+
+    // Hash seed only needs to change in the astronomically unlikely event of a
+    // 64-bit hash collision between two message types.
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(configs_.size());
+    for (std::uint64_t seed = 0;; ++seed) {
+      hashes.clear();
+      for (const auto& config : configs_) {
+        hashes.push_back(internal::hashKey<CharT>(config.first, seed));
+      }
+      if (index_.build(hashes)) {
+        hashSeed_ = seed;
+        break;
+      }
+    }
+
+    // Slot assignment depends only on the set of message types, so identify
+    // that set by an order-independent combination of its hashes.
+    std::uint64_t keySetId = internal::mix64(hashes.size());
+    for (const auto hash : hashes) {
+      keySetId += internal::mix64(hash);
+    }
+    keySetId_ = internal::mix64(keySetId ^ hashSeed_);
+
+    // Place each message (and its hash, if compared instead) at its slot.
+    const bool keepKeys = (keyStorage_ != KeyStorage::kHashOnly);
+    std::vector<typename map_type::iterator> slotConfigs(configs_.size());
+    if (keyStorage_ != KeyStorage::kFull) {
+      keyHashes_.resize(configs_.size());
+    }
+    std::size_t i = 0;
+    for (auto itr = configs_.begin(); itr != configs_.end(); ++itr, ++i) {
+      const std::size_t slot = index_.slot(hashes[i]);
+      slotConfigs[slot] = itr;
+      if (!keyHashes_.empty()) {
+        keyHashes_[slot] = hashes[i];
+      }
+    }
+
+    // Size the packed buffers up front: entries hold views into them, so they
+    // must never reallocate.
+    std::size_t textSize = 0;
+    std::size_t numCases = 0;
+    std::size_t numSegments = 0;
+    for (const auto& config : configs_) {
+      textSize += keepKeys ? config.first.size() : 0;
+      for (const auto& msgCase : config.second.cases()) {
+        textSize += msgCase.msg().size();
+        numSegments += msgCase.segments().size();
+        ++numCases;
+      }
+    }
+    if (pool_ == nullptr) {
+      text_.reserve(textSize);
+    }
+    segments_.reserve(numSegments);
+    cases_.reserve(numCases);
+    entries_.reserve(slotConfigs.size());
+
+    for (const auto& itr : slotConfigs) {
+      const basic_string_view<CharT> msgType =
+          keepKeys ? pack(itr->first) : basic_string_view<CharT>{};
+      const MsgConfig<CharT>& config = itr->second;
+
+      const PluralCase<CharT>* const firstCase = cases_.data() + cases_.size();
+      for (const auto& msgCase : config.cases()) {
+        const internal::MsgSegment* const firstSegment = segments_.data() + segments_.size();
+        segments_.insert(segments_.end(), msgCase.segments().begin(), msgCase.segments().end());
+        cases_.push_back(PluralCase<CharT>{
+            msgCase.count(), pack(msgCase.msg()), firstSegment, msgCase.segments().size()});
+      }
+
+      entries_.push_back(Entry{
+          msgType,
+          MsgConfig<CharT>{
+              firstCase, config.numCases_, config.numSlots_, config.numBoundArgs_,
+              config.boundArgsHash_}});
+    }
+
+    configs_.clear();
+    frozen_ = true;
+  }
+
+  /**
+   * Serializes this frozen MsgConfigs as a binary catalog (see
+   * catalog_format.hpp), which viewCatalog() can use in place.
+   */
+  std::string toCatalog() const {
+    Expects(frozen_);
+    Expects(keyStorage_ != KeyStorage::kHashOnly);
+
+    std::vector<internal::CatalogEntry> entries;
+    std::vector<internal::CatalogCase> cases;
+    internal::MsgSegments segments;
+    string_type text;
+    entries.reserve(entries_.size());
+
+    const auto pack = [&text](basic_string_view<CharT> str) {
+      Expects(text.size() + str.size() <= std::numeric_limits<std::uint32_t>::max());
+      const auto offset = gsl::narrow_cast<std::uint32_t>(text.size());
+      text.append(str.data(), str.size());
+      return offset;
+    };
+
+    for (const auto& entry : entries_) {
+      const auto& config = entry.config;
+      entries.push_back(internal::CatalogEntry{
+          pack(entry.msgType), gsl::narrow_cast<std::uint32_t>(entry.msgType.size()),
+          gsl::narrow_cast<std::uint32_t>(cases.size()), config.numCases_, config.numBoundArgs_,
+          gsl::narrow_cast<std::uint32_t>(config.numSlots_), config.boundArgsHash_});
+
+      for (const auto& msgCase : config.cases()) {
+        cases.push_back(internal::CatalogCase{
+            msgCase.count(), pack(msgCase.msg()),
+            gsl::narrow_cast<std::uint32_t>(msgCase.msg().size()),
+            gsl::narrow_cast<std::uint32_t>(segments.size()),
+            gsl::narrow_cast<std::uint32_t>(msgCase.segments().size())});
+        segments.insert(segments.end(), msgCase.segments().begin(), msgCase.segments().end());
+      }
+    }
+
+    internal::CatalogHeader header{};
+    std::memcpy(header.magic, internal::kCatalogMagic, sizeof(header.magic));
+    header.version = internal::kCatalogVersion;
+    header.byteOrder = internal::kCatalogByteOrder;
+    header.charSize = sizeof(CharT);
+    header.numEntries = gsl::narrow_cast<std::uint32_t>(entries.size());
+    header.numCases = gsl::narrow_cast<std::uint32_t>(cases.size());
+    header.numSegments = gsl::narrow_cast<std::uint32_t>(segments.size());
+    header.numPilots = gsl::narrow_cast<std::uint32_t>(index_.pilots().size());
+    header.textSize = text.size();
+    header.hashSeed = hashSeed_;
+    header.keySetId = keySetId_;
+
+    const auto layout = internal::CatalogLayout::of<CharT>(header);
+    std::string catalog(gsl::narrow_cast<std::size_t>(layout.size), '\0');
+    const auto copySection = [&catalog](std::uint64_t offset, const void* data, std::size_t size) {
+      if (size > 0) {
+        std::memcpy(&catalog[gsl::narrow_cast<std::size_t>(offset)], data, size);
+      }
+    };
+    copySection(0, &header, sizeof(header));
+    copySection(layout.entries, entries.data(), entries.size() * sizeof(internal::CatalogEntry));
+    copySection(layout.cases, cases.data(), cases.size() * sizeof(internal::CatalogCase));
+    copySection(
+        layout.segments, segments.data(), segments.size() * sizeof(internal::MsgSegment));
+    copySection(
+        layout.pilots, index_.pilots().data(), index_.pilots().size() * sizeof(std::uint32_t));
+    copySection(layout.text, text.data(), text.size() * sizeof(CharT));
+    return catalog;
+  }
+
+  /**
+   * Freezes this empty MsgConfigs by viewing a binary catalog (as written by
+   * toCatalog()) in place: message types, texts and segments are used
+   * directly from data, which must be aligned to 8 bytes and stay unchanged
+   * while this MsgConfigs exists. storage is kept alive until then (e.g. to
+   * own a memory mapping of data).
+   *
+   * Returns false (leaving this empty and not frozen) if data isn't a valid
+   * catalog of CharT messages for this machine. Validation guarantees that
+   * lookups stay within data, but not that message types were hashed
+   * correctly, so catalogs should come from trusted builds.
+   */
+  bool viewCatalog(const void* data, std::size_t size, std::shared_ptr<const void> storage) {
+    Expects(!frozen_);
+    Expects(configs_.empty());
+    Expects(keyStorage_ == KeyStorage::kFull);
+
+    const auto* const bytes = static_cast<const char*>(data);
+    if (reinterpret_cast<std::uintptr_t>(data) % internal::kCatalogAlignment != 0
+        || size < sizeof(internal::CatalogHeader)) {
+      return false;
+    }
+
+    internal::CatalogHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, internal::kCatalogMagic, sizeof(header.magic)) != 0
+        || header.version < internal::kMinCatalogVersion
+        || header.version > internal::kCatalogVersion
+        || header.byteOrder != internal::kCatalogByteOrder || header.charSize != sizeof(CharT)
+        || header.textSize > std::numeric_limits<std::uint32_t>::max()) {
+      return false;
+    }
+
+    const auto layout = internal::CatalogLayout::of<CharT>(header);
+    if (layout.size > size
+        || !index_.view(
+            reinterpret_cast<const std::uint32_t*>(bytes + layout.pilots), header.numPilots,
+            header.numEntries)) {
+      return false;
+    }
+
+    const auto* const entries =
+        reinterpret_cast<const internal::CatalogEntry*>(bytes + layout.entries);
+    const auto* const cases = reinterpret_cast<const internal::CatalogCase*>(bytes + layout.cases);
+    const auto* const segments =
+        reinterpret_cast<const internal::MsgSegment*>(bytes + layout.segments);
+    const basic_string_view<CharT> text{
+        reinterpret_cast<const CharT*>(bytes + layout.text),
+        gsl::narrow_cast<std::size_t>(header.textSize)};
+
+    cases_.reserve(header.numCases);
+    for (std::uint32_t i = 0; i < header.numCases; ++i) {
+      const auto& msgCase = cases[i];
+      if ((msgCase.count < internal::categoryCount(PluralCategory::kOther))
+          || !inRange(msgCase.msgOffset, msgCase.msgLength, text.size())
+          || !inRange(msgCase.firstSegment, msgCase.numSegments, header.numSegments)) {
+        return failView();
+      }
+      for (std::uint32_t j = 0; j < msgCase.numSegments; ++j) {
+        const auto& segment = segments[msgCase.firstSegment + j];
+        if (!inRange(segment.offset, segment.length, msgCase.msgLength)) {
+          return failView();
+        }
+      }
+
+      cases_.push_back(PluralCase<CharT>{
+          msgCase.count, text.substr(msgCase.msgOffset, msgCase.msgLength),
+          segments + msgCase.firstSegment, msgCase.numSegments});
+    }
+
+    entries_.reserve(header.numEntries);
+    for (std::uint32_t i = 0; i < header.numEntries; ++i) {
+      const auto& entry = entries[i];
+      if (!inRange(entry.msgTypeOffset, entry.msgTypeLength, text.size())
+          || !inRange(entry.firstCase, entry.numCases, header.numCases) || entry.numCases == 0
+          || (entry.numBoundArgs != -1
+              && static_cast<std::uint32_t>(entry.numBoundArgs) != entry.numSlots)) {
+        return failView();
+      }
+
+      // Slots index per-call tables, so must stay within numSlots, which is at
+      // most the number of argument segments.
+      std::size_t numArgs = 0;
+      for (std::uint32_t j = 0; j < entry.numCases; ++j) {
+        for (const auto& segment : cases_[entry.firstCase + j].segments()) {
+          if (segment.isArg()) {
+            ++numArgs;
+            if (segment.slot >= entry.numSlots && segment.slot != internal::kUnboundSlot) {
+              return failView();
+            }
+          }
+        }
+      }
+      if (entry.numSlots > numArgs || !validCategories(&cases_[entry.firstCase], entry.numCases)) {
+        return failView();
+      }
+
+      entries_.push_back(Entry{
+          text.substr(entry.msgTypeOffset, entry.msgTypeLength),
+          MsgConfig<CharT>{
+              &cases_[entry.firstCase], entry.numCases, entry.numSlots, entry.numBoundArgs,
+              entry.boundArgsHash}});
+    }
+
+    hashSeed_ = header.hashSeed;
+    keySetId_ = header.keySetId;
+    storage_ = std::move(storage);
+    frozen_ = true;
+    return true;
+  }
+
+  /**
+   * Sets the plural rules of this locale, which select the PluralCategory
+   * case of messages configured with them (by default, only kOther cases are
+   * ever selected). Unlike messages, rules can be set after freezing (e.g.
+   * once a binary catalog is viewed), but not while translating.
+   */
+  void setPluralRules(PluralRules rules) { pluralRules_ = std::move(rules); }
+
+  /** Plural rules of this locale (see setPluralRules()). */
+  const PluralRules& pluralRules() const { return pluralRules_; }
+
+  /** Returns true if freeze() (or viewCatalog()) has been called. */
+  bool frozen() const { return frozen_; }
+
+  /**
+   * Marks this frozen MsgConfigs as verified against a reference catalog:
+   * every plural count >= 0 selects a case of each plural message. Called by
+   * verifyCatalogs() (see catalog_validator.hpp) for catalogs without issues.
+   *
+   * SimpleTranslators built from a verified MsgConfigs skip measuring each
+   * translation, rendering in a single pass. Errors are still reported, but
+   * a missing argument is only found while rendering, so sinks without a
+   * resize() member keep the output appended before it.
+   */
+  void markVerified() {
+    Expects(frozen_);
+    verified_ = true;
+  }
+
+  /** Returns true if markVerified() has been called. */
+  bool verified() const { return verified_; }
+
+  /** Number of messages added. */
+  std::size_t size() const { return frozen_ ? entries_.size() : configs_.size(); }
+
+  /**
+   * Identifies the set of message types in this frozen MsgConfigs. Frozen
+   * MsgConfigs with equal keySetId() values have the same message types at the
+   * same indexes.
+   */
+  std::uint64_t keySetId() const {
+    Expects(frozen_);
+    return keySetId_;
+  }
+
+  /**
+   * Returns the index of the given message type in this frozen MsgConfigs, or
+   * MsgId<CharT>::kUnresolved if it is not configured.
+   */
+  std::uint32_t indexOf(basic_string_view<CharT> msgType) const {
+    Expects(frozen_);
+    if (!entries_.empty()) {
+      const std::uint64_t hash = internal::hashKey<CharT>(msgType, hashSeed_);
+      const auto slot = index_.slot(hash);
+      if (keyHashes_.empty() ? (entries_[slot].msgType == msgType) : (keyHashes_[slot] == hash)) {
+        return gsl::narrow_cast<std::uint32_t>(slot);
+      }
+    }
+    return MsgId<CharT>::kUnresolved;
+  }
+
+  /** Accesses the configuration at the given index (< size()) of this frozen MsgConfigs. */
+  const MsgConfig<CharT>& at(std::uint32_t index) const {
+    Expects(frozen_);
+    Expects(index < entries_.size());
+    return entries_[index].config;
+  }
+
+  /**
+   * Returns the configuration for the given message type in this frozen
+   * MsgConfigs, or nullptr if it is not configured (whatever the build mode).
+   */
+  const MsgConfig<CharT>* find(basic_string_view<CharT> msgType) const {
+    const std::uint32_t index = indexOf(msgType);
+    return (index != MsgId<CharT>::kUnresolved) ? &entries_[index].config : nullptr;
+  }
+
+  /**
+   * Message type at the given index (< size()) of this frozen MsgConfigs, or
+   * an empty view for KeyStorage::kHashOnly (see setKeyStorage()).
+   */
+  basic_string_view<CharT> msgTypeAt(std::uint32_t index) const {
+    Expects(frozen_);
+    Expects(index < entries_.size());
+    return entries_[index].msgType;
+  }
+
+  /** Returns true if a message with the given type has been added. */
+  bool has(basic_string_view<CharT> msgType) const {
+    return frozen_ ? (find(msgType) != nullptr) : (configs_.find(msgType) != configs_.end());
+  }
+
   /** Accesses the configuration for the given message type. */
   const MsgConfig<CharT>& get(basic_string_view<CharT> msgType) const {
-    const auto itr = configs_.find(msgType);
+    if (frozen_) {
+      const MsgConfig<CharT>* config = find(msgType);
+      return (config != nullptr) ? *config : notFound(msgType);
+    }
 
+    const auto itr = configs_.find(msgType);
     if (itr == configs_.end()) {
-      // This message type was not configured.
+      return notFound(msgType);
+    }
+
+    return itr->second;
+  }
+
+private:
+  using map_type = std::map<string_type, MsgConfig<CharT>, std::less<>>;
+
+  struct Entry {
+    basic_string_view<CharT> msgType;
+    MsgConfig<CharT> config;
+  };
+
+  static bool inRange(std::uint32_t offset, std::uint32_t length, std::uint64_t size) {
+    return static_cast<std::uint64_t>(offset) + length <= size;
+  }
+
+  /**
+   * Returns true if each category case of a viewed message is unique and
+   * follows all count cases (as MsgConfig packs them).
+   */
+  static bool validCategories(const PluralCase<CharT>* cases, std::uint32_t numCases) {
+    std::array<bool, kNumPluralCategories> seen{};
+    for (std::uint32_t i = 0; i < numCases; ++i) {
+      if (!cases[i].hasCategory()) {
+        if (i > 0 && cases[i - 1].hasCategory()) {
+          return false;
+        }
+        continue;
+      }
+      bool& seenCategory = seen[static_cast<std::size_t>(cases[i].category())];
+      if (seenCategory || i >= 0xff) {
+        return false;
+      }
+      seenCategory = true;
+    }
+    return true;
+  }
+
+  bool failView() {
+    entries_.clear();
+    cases_.clear();
+    index_ = internal::PerfectHash{};
+    return false;
+  }
+
+  /**
+   * Appends text to the packed text buffer (which must have room), or interns
+   * it in the pool, returning a view of it.
+   */
+  basic_string_view<CharT> pack(basic_string_view<CharT> text) {
+    if (pool_ != nullptr) {
+      return pool_->intern(text);
+    }
+
+    Expects(text_.size() + text.size() <= text_.capacity());
+    const std::size_t offset = text_.size();
+    text_.append(text.data(), text.size());
+    return basic_string_view<CharT>{text_.data() + offset, text.size()};
+  }
+
+  const MsgConfig<CharT>& notFound(basic_string_view<CharT> msgType) const {
+    // This message type was not configured.
 #ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
-      throw MissingMsgTypeException<CharT>{msgType};
+    throw MissingMsgTypeException<CharT>{msgType};
 #else
-      return emptyConfig_;
+    static_cast<void>(msgType);  // Suppress unreferenced parameter warning.
+    return emptyConfig_;
 #endif
+  }
+
+  MsgConfigs& addBound(
+      basic_string_view<CharT> msgType, MsgConfig<CharT> config,
+      const basic_string_view<CharT>* argKeys, std::size_t numArgKeys, std::uint64_t argKeysHash) {
+    Expects(!frozen_);
+    const auto unboundKey = config.bindArgs(argKeys, numArgKeys, argKeysHash);
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+    if (!unboundKey.empty()) {
+      throw MissingArgException<CharT>{msgType, unboundKey};
     }
+#else
+    static_cast<void>(unboundKey);  // Unbound arguments will be substituted as empty strings.
+#endif
 
-    return itr->second;
+    configs_.emplace(msgType, std::move(config));
+    return *this;
   }
 
-private:
-  // Note: Using transparent comparator std::less<> to support heterogeneous
-  // lookup by string_view without key type conversion.
-  std::map<string_type, MsgConfig<CharT>, std::less<>> configs_;
+  // While building. Note: Using transparent comparator std::less<> to support
+  // heterogeneous lookup by string_view without key type conversion.
+  map_type configs_;
+
+  // Once frozen: entries indexed by perfect hash slot, viewing cases, segments
+  // and text packed into shared buffers.
+  std::vector<Entry> entries_;
+  std::vector<std::uint64_t> keyHashes_;  // By slot, unless KeyStorage::kFull.
+  std::vector<PluralCase<CharT>> cases_;
+  internal::MsgSegments segments_;
+  string_type text_;  // Unless frozen into pool_.
+  std::shared_ptr<StringPool<CharT>> pool_;  // Null unless frozen into a pool.
+  std::shared_ptr<const void> storage_;  // Owns viewed catalog data, if any.
+  internal::PerfectHash index_;
+  PluralRules pluralRules_;
+  std::uint64_t hashSeed_ = 0;
+  std::uint64_t keySetId_ = 0;
+  KeyStorage keyStorage_ = KeyStorage::kFull;
+  bool frozen_ = false;
+  bool verified_ = false;
+
   MsgConfig<CharT> emptyConfig_{string_type{}};
 };
 
+template<typename CharT>
+class ReloadableTranslator;
+
 /**
  * A very simple Translator implementation that is configured at construction
  * time by passing all translations for the desired locale in a single
  * configuration object.
+ *
+ * Final, so that calls through a SimpleTranslator reference (or a
+ * StaticTranslator<SimpleTranslator<CharT>>) are dispatched statically.
  */
 template<typename CharT>
-class SimpleTranslator : public Translator<CharT> {
+class SimpleTranslator final : public Translator<CharT> {
 public:
   using string_type = typename Translator<CharT>::string_type;
 
-  SimpleTranslator(std::unique_ptr<MsgConfigs<CharT>> configs) : configs_{std::move(configs)} {}
+  using Translator<CharT>::translate;
+  using Translator<CharT>::translatePlural;
+
+  /**
+   * Freezes the given configs (if not already frozen) for fast lookups. If
+   * they are verified (see MsgConfigs::markVerified()), translations render
+   * in a single pass without measuring first. Errors are still reported, but
+   * append-only sinks (without resize()) keep partial output on a missing
+   * argument.
+   */
+  SimpleTranslator(std::unique_ptr<MsgConfigs<CharT>> configs) : configs_{std::move(configs)} {
+    Expects(configs_ != nullptr);
+    configs_->freeze();
+    verified_ = configs_->verified();
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+    metrics_.setNumMsgs(configs_->size());
+#endif
+  }
 
   ~SimpleTranslator() override = default;
 
@@ -215,100 +1091,682 @@ public:
   SimpleTranslator& operator=(SimpleTranslator&&) = delete;
 
   string_type translate(basic_string_view<CharT> msgType) const override {
-    const auto& config = configs_->get(msgType);
+    string_type result;
+    render(result, msgType, findConfig(msgType), internal::kNoCount, NoArgsLookup{});
+    return result;
+  }
 
-    if (config.hasPluralCases()) {
-      return invalidArgs(msgType);  // Mismatch: must use translatePlural().
-    }
+  string_type translate(
+      basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const override {
+    string_type result;
+    render(result, msgType, findConfig(msgType), internal::kNoCount, TransArgsLookup{args});
+    return result;
+  }
 
-    const auto& msg = config.onlyCase();
+  string_type translatePlural(
+      basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const override {
+    Expects(pluralCount >= 0);
+    string_type result;
+    render(result, msgType, findConfig(msgType), pluralCount, TransArgsLookup{args});
+    return result;
+  }
 
-    match_type match;
-    if (std::regex_search(msg, match, argPattern_)) {
-      const std::basic_string<CharT> argKey = match[1];
-      return missingArg(msgType, argKey);
-    }
+  // Note: Hide the Translator MsgDescriptor overloads, so that (this class
+  // being final) they reach translatePositional() without virtual dispatch.
+  /** See Translator::translate(msg, values...). */
+  template<std::size_t NumArgs, typename... Values>
+  string_type translate(const MsgDescriptor<CharT, NumArgs>& msg, const Values&... values) const {
+    const internal::PositionalValues<CharT, NumArgs> valueViews{values...};
+    return translatePositional(
+        msg.msgType(), internal::kNoCount, msg.argKeys().data(), msg.argKeysHash(),
+        valueViews.data(), NumArgs);
+  }
 
-    return msg;
+  /** See Translator::translatePlural(msg, pluralCount, values...). */
+  template<std::size_t NumArgs, typename... Values>
+  string_type translatePlural(
+      const MsgDescriptor<CharT, NumArgs>& msg, int pluralCount, const Values&... values) const {
+    Expects(pluralCount >= 0);
+    const internal::PositionalValues<CharT, NumArgs> valueViews{values...};
+    return translatePositional(
+        msg.msgType(), pluralCount, msg.argKeys().data(), msg.argKeysHash(), valueViews.data(),
+        NumArgs);
   }
 
-  string_type translate(
-      basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const override {
-    const auto& config = configs_->get(msgType);
+  /**
+   * Resolves the message type to its index in this translator's MsgConfigs.
+   * The handle can be used with any SimpleTranslator configured with the same
+   * set of message types.
+   */
+  MsgId<CharT> resolve(basic_string_view<CharT> msgType) const override {
+    return MsgId<CharT>{msgType, configs_->indexOf(msgType), configs_->keySetId()};
+  }
 
-    if (config.hasPluralCases()) {
-      return invalidArgs(msgType);  // Mismatch: must use translatePlural().
-    }
+  string_type translate(const MsgId<CharT>& msgId) const override {
+    string_type result;
+    render(result, msgId.msgType(), findConfig(msgId), internal::kNoCount, NoArgsLookup{});
+    return result;
+  }
 
-    return substituteArgs(msgType, config.onlyCase(), args);
+  string_type translate(const MsgId<CharT>& msgId, const TransArgs<CharT>& args) const override {
+    string_type result;
+    render(result, msgId.msgType(), findConfig(msgId), internal::kNoCount, TransArgsLookup{args});
+    return result;
   }
 
   string_type translatePlural(
-      basic_string_view<CharT> msgType, int pluralCount,
+      const MsgId<CharT>& msgId, int pluralCount, const TransArgs<CharT>& args) const override {
+    Expects(pluralCount >= 0);
+    string_type result;
+    render(result, msgId.msgType(), findConfig(msgId), pluralCount, TransArgsLookup{args});
+    return result;
+  }
+
+  void translateTo(string_type& out, basic_string_view<CharT> msgType) const override {
+    render(out, msgType, findConfig(msgType), internal::kNoCount, NoArgsLookup{});
+  }
+
+  void translateTo(
+      string_type& out, basic_string_view<CharT> msgType,
+      const TransArgs<CharT>& args) const override {
+    render(out, msgType, findConfig(msgType), internal::kNoCount, TransArgsLookup{args});
+  }
+
+  void translatePluralTo(
+      string_type& out, basic_string_view<CharT> msgType, int pluralCount,
       const TransArgs<CharT>& args) const override {
     Expects(pluralCount >= 0);
-    const auto& config = configs_->get(msgType);
+    render(out, msgType, findConfig(msgType), pluralCount, TransArgsLookup{args});
+  }
 
-    if (!config.hasPluralCases()) {
-      return invalidArgs(msgType);  // Mismatch: must use translate().
+  /**
+   * Renders each request straight into out, with no virtual dispatch or
+   * per-translation strings. (Reordering requests to group lookups by catalog
+   * position was measured not to help: each lookup is a single probe, and
+   * measuring and rendering a message back to back keeps it in cache.)
+   */
+  void translateBatch(
+      gsl::span<const TransRequest<CharT>> requests, string_type& out,
+      std::vector<std::size_t>& offsets) const override {
+    out.clear();
+    offsets.clear();
+    offsets.reserve(requests.size() + 1);
+    for (const auto& request : requests) {
+      Expects((request.pluralCount == internal::kNoCount) || (request.pluralCount >= 0));
+      offsets.push_back(out.size());
+      withLookup(request, [&](auto& lookup) {
+        render(out, request.msgType, findConfig(request.msgType), request.pluralCount, lookup);
+      });
     }
+    offsets.push_back(out.size());
+  }
+
+  /**
+   * Same as translateTo() with a string, but appends to any Sink type with an
+   * append(const CharT* data, std::size_t size) member function. If Sink also
+   * has size(), capacity() and reserve() members (like std::basic_string),
+   * room for the whole translation is reserved before appending.
+   */
+  template<typename Sink>
+  void translateTo(Sink& sink, basic_string_view<CharT> msgType) const {
+    render(sink, msgType, findConfig(msgType), internal::kNoCount, NoArgsLookup{});
+  }
+
+  /** Same as translateTo() with a string, but appends to any Sink type (see above). */
+  template<typename Sink>
+  void translateTo(
+      Sink& sink, basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const {
+    render(sink, msgType, findConfig(msgType), internal::kNoCount, TransArgsLookup{args});
+  }
+
+  /** Same as translatePluralTo() with a string, but appends to any Sink type (see above). */
+  template<typename Sink>
+  void translatePluralTo(
+      Sink& sink, basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    render(sink, msgType, findConfig(msgType), pluralCount, TransArgsLookup{args});
+  }
+
+  /**
+   * Same as translate(msgType), but returns a string using the given
+   * allocator, e.g. a std::pmr::polymorphic_allocator<CharT> over a
+   * request-scoped std::pmr::monotonic_buffer_resource:
+   *
+   *   std::pmr::basic_string<CharT> msg =
+   *       translator.translate(std::allocator_arg, alloc, msgType, args);
+   *
+   * Rendering needs no intermediate buffers (it measures, then appends
+   * straight into the result), so the result's one allocation comes from the
+   * given allocator, and nothing from the global heap.
+   */
+  template<typename Allocator>
+  std::basic_string<CharT, std::char_traits<CharT>, Allocator> translate(
+      std::allocator_arg_t, const Allocator& alloc, basic_string_view<CharT> msgType) const {
+    std::basic_string<CharT, std::char_traits<CharT>, Allocator> result{alloc};
+    render(result, msgType, findConfig(msgType), internal::kNoCount, NoArgsLookup{});
+    return result;
+  }
+
+  /** Same as translate(msgType, args), but with the given allocator (see above). */
+  template<typename Allocator>
+  std::basic_string<CharT, std::char_traits<CharT>, Allocator> translate(
+      std::allocator_arg_t, const Allocator& alloc, basic_string_view<CharT> msgType,
+      const TransArgs<CharT>& args) const {
+    std::basic_string<CharT, std::char_traits<CharT>, Allocator> result{alloc};
+    render(result, msgType, findConfig(msgType), internal::kNoCount, TransArgsLookup{args});
+    return result;
+  }
+
+  /** Same as translate(msgId, args), but with the given allocator (see above). */
+  template<typename Allocator>
+  std::basic_string<CharT, std::char_traits<CharT>, Allocator> translate(
+      std::allocator_arg_t, const Allocator& alloc, const MsgId<CharT>& msgId,
+      const TransArgs<CharT>& args) const {
+    std::basic_string<CharT, std::char_traits<CharT>, Allocator> result{alloc};
+    render(result, msgId.msgType(), findConfig(msgId), internal::kNoCount, TransArgsLookup{args});
+    return result;
+  }
+
+  /** Same as translatePlural(msgType, pluralCount, args), but with the given allocator. */
+  template<typename Allocator>
+  std::basic_string<CharT, std::char_traits<CharT>, Allocator> translatePlural(
+      std::allocator_arg_t, const Allocator& alloc, basic_string_view<CharT> msgType,
+      int pluralCount, const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    std::basic_string<CharT, std::char_traits<CharT>, Allocator> result{alloc};
+    render(result, msgType, findConfig(msgType), pluralCount, TransArgsLookup{args});
+    return result;
+  }
 
-    return substituteArgs(msgType, config.pluralCase(msgType, pluralCount), args);
+  /** Same as translatePlural(msgId, pluralCount, args), but with the given allocator. */
+  template<typename Allocator>
+  std::basic_string<CharT, std::char_traits<CharT>, Allocator> translatePlural(
+      std::allocator_arg_t, const Allocator& alloc, const MsgId<CharT>& msgId, int pluralCount,
+      const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    std::basic_string<CharT, std::char_traits<CharT>, Allocator> result{alloc};
+    render(result, msgId.msgType(), findConfig(msgId), pluralCount, TransArgsLookup{args});
+    return result;
+  }
+
+  /**
+   * Returns the exact size of the string translate(msgType) would return,
+   * without rendering it. Errors are handled the same as translate() (with
+   * exceptions disabled, 0 is returned).
+   */
+  std::size_t renderedSize(basic_string_view<CharT> msgType) const {
+    return measure(msgType, findConfig(msgType), internal::kNoCount, NoArgsLookup{});
+  }
+
+  /** Same as renderedSize(msgType), but for translate(msgType, args). */
+  std::size_t renderedSize(basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const {
+    return measure(msgType, findConfig(msgType), internal::kNoCount, TransArgsLookup{args});
+  }
+
+  /** Same as renderedSize(msgType), but for translatePlural(msgType, pluralCount, args). */
+  std::size_t renderedPluralSize(
+      basic_string_view<CharT> msgType, int pluralCount, const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    return measure(msgType, findConfig(msgType), pluralCount, TransArgsLookup{args});
+  }
+
+  /**
+   * Same as translate(msgType), but returns any error in the result instead of
+   * throwing (or returning an empty string), in either build mode. Failing
+   * doesn't allocate, which suits hot paths that expect some failures (e.g.
+   * message types missing during a rollout).
+   */
+  TransResult<CharT> tryTranslate(basic_string_view<CharT> msgType) const {
+    return tryRenderResult(msgType, findConfig(msgType), internal::kNoCount, NoArgsLookup{});
+  }
+
+  /** Same as tryTranslate(msgType), but for translate(msgType, args). */
+  TransResult<CharT> tryTranslate(
+      basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const {
+    return tryRenderResult(
+        msgType, findConfig(msgType), internal::kNoCount, TransArgsLookup{args});
+  }
+
+  /** Same as tryTranslate(msgType), but for translatePlural(msgType, pluralCount, args). */
+  TransResult<CharT> tryTranslatePlural(
+      basic_string_view<CharT> msgType, int pluralCount, const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    return tryRenderResult(msgType, findConfig(msgType), pluralCount, TransArgsLookup{args});
+  }
+
+  /** Same as tryTranslate(msgType), but for translate(msgId). */
+  TransResult<CharT> tryTranslate(const MsgId<CharT>& msgId) const {
+    return tryRenderResult(
+        msgId.msgType(), findConfig(msgId), internal::kNoCount, NoArgsLookup{});
+  }
+
+  /** Same as tryTranslate(msgType), but for translate(msgId, args). */
+  TransResult<CharT> tryTranslate(const MsgId<CharT>& msgId, const TransArgs<CharT>& args) const {
+    return tryRenderResult(
+        msgId.msgType(), findConfig(msgId), internal::kNoCount, TransArgsLookup{args});
+  }
+
+  /** Same as tryTranslate(msgType), but for translatePlural(msgId, pluralCount, args). */
+  TransResult<CharT> tryTranslatePlural(
+      const MsgId<CharT>& msgId, int pluralCount, const TransArgs<CharT>& args) const {
+    Expects(pluralCount >= 0);
+    return tryRenderResult(
+        msgId.msgType(), findConfig(msgId), pluralCount, TransArgsLookup{args});
+  }
+
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  /**
+   * Returns the metrics recorded by this translator so far, summed over all
+   * threads: hits per message type (including renderedSize() calls), errors,
+   * and sampled render latencies. Errors are counted whether or not
+   * exceptions are enabled.
+   */
+  MetricsSnapshot<CharT> metrics() const {
+    return metrics_.snapshot([this](std::uint32_t index) { return configs_->msgTypeAt(index); });
+  }
+
+  /**
+   * Samples the render latency of one in every interval translations on each
+   * thread (64 by default, or 0 to disable sampling). Thread safe.
+   */
+  void setLatencySampleInterval(std::uint32_t interval) const {
+    metrics_.setLatencySampleInterval(interval);
+  }
+#endif
+
+protected:
+  string_type translatePositional(
+      basic_string_view<CharT> msgType, int pluralCount, const basic_string_view<CharT>* argKeys,
+      std::uint64_t argKeysHash, const basic_string_view<CharT>* values,
+      std::size_t numArgs) const override {
+    const MsgConfig<CharT>* config = findConfig(msgType);
+    string_type result;
+
+    if ((config != nullptr) && (config->numBoundArgs() == gsl::narrow_cast<int>(numArgs))
+        && (config->boundArgsHash() == argKeysHash)) {
+      // Bound to this MsgDescriptor (same keys, in the same order) when added,
+      // so argument slots index values directly and every argument is known to
+      // be present.
+      render(result, msgType, config, pluralCount, SlotValuesLookup{values, numArgs, {}});
+    } else {
+      // Added without this MsgDescriptor (or bound to a different version of
+      // it), so match argument keys by value.
+      render(result, msgType, config, pluralCount, KeyedValuesLookup{argKeys, values, numArgs});
+    }
+
+    return result;
   }
 
 private:
-  using match_type = std::match_results<typename std::basic_string<CharT>::const_iterator>;
+  friend class ReloadableTranslator<CharT>;  // Delegates translatePositional().
 
-  static string_type invalidArgs(basic_string_view<CharT> msgType) {
-#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
-    throw InvalidArgsException<CharT>{msgType};
-#else
-    static_cast<void>(msgType);  // Suppress unreferenced parameter warning.
-    return {};
+  // Argument value lookups for render(). Each returns a pointer to the value
+  // for the given argument segment (with text argKey), or nullptr if missing.
+
+  struct NoArgsLookup {
+    const basic_string_view<CharT>* operator()(
+        const internal::MsgSegment&, basic_string_view<CharT>) const {
+      return nullptr;
+    }
+  };
+
+  /**
+   * Caches the value found for each argument slot by a key-based Find lookup,
+   * so that each distinct argument is only looked up once per translation no
+   * matter how many times the message (or the two render passes) use it.
+   */
+  template<typename Find>
+  class SlotCacheLookup {
+  public:
+    explicit SlotCacheLookup(const Find& find) : find_{find} {}
+
+    const basic_string_view<CharT>* operator()(
+        const internal::MsgSegment& segment, basic_string_view<CharT> argKey) {
+      if (segment.slot == internal::kUnboundSlot) {
+        return find_(argKey);
+      }
+
+      const basic_string_view<CharT>** cached = nullptr;
+      if (segment.slot < kInlineSlots) {
+        cached = &inlineValues_[segment.slot];
+      } else {
+        if (heapValues_.size() <= segment.slot - kInlineSlots) {
+          heapValues_.resize(segment.slot - kInlineSlots + 1, nullptr);
+        }
+        cached = &heapValues_[segment.slot - kInlineSlots];
+      }
+
+      if (*cached == nullptr) {
+        *cached = find_(argKey);
+      }
+      return *cached;
+    }
+
+  private:
+    static constexpr std::size_t kInlineSlots = 16;
+
+    Find find_;
+    std::array<const basic_string_view<CharT>*, kInlineSlots> inlineValues_{};
+    std::vector<const basic_string_view<CharT>*> heapValues_;
+  };
+
+  struct FindInTransArgs {
+    const TransArgs<CharT>& args;
+
+    const basic_string_view<CharT>* operator()(basic_string_view<CharT> argKey) const {
+      return args.find(argKey);
+    }
+  };
+
+  struct FindInKeyedValues {
+    const basic_string_view<CharT>* argKeys;
+    const basic_string_view<CharT>* values;
+    std::size_t numArgs;
+
+    const basic_string_view<CharT>* operator()(basic_string_view<CharT> argKey) const {
+      const auto* const itr = std::find(argKeys, argKeys + numArgs, argKey);
+      return (itr != argKeys + numArgs) ? &values[itr - argKeys] : nullptr;
+    }
+  };
+
+  struct TransArgsLookup : SlotCacheLookup<FindInTransArgs> {
+    explicit TransArgsLookup(const TransArgs<CharT>& args)
+        : SlotCacheLookup<FindInTransArgs>{FindInTransArgs{args}} {}
+  };
+
+  struct KeyedValuesLookup : SlotCacheLookup<FindInKeyedValues> {
+    KeyedValuesLookup(
+        const basic_string_view<CharT>* argKeys, const basic_string_view<CharT>* values,
+        std::size_t numArgs)
+        : SlotCacheLookup<FindInKeyedValues>{FindInKeyedValues{argKeys, values, numArgs}} {}
+  };
+
+  struct SlotValuesLookup {
+    const basic_string_view<CharT>* values;
+    std::size_t numArgs;
+    basic_string_view<CharT> unbound;  // Substituted for arguments that failed to bind.
+
+    const basic_string_view<CharT>* operator()(
+        const internal::MsgSegment& segment, basic_string_view<CharT>) const {
+      return (segment.slot < numArgs) ? &values[segment.slot] : &unbound;
+    }
+  };
+
+  /** Calls fn with an argument lookup for the given batch request. */
+  template<typename Fn>
+  static void withLookup(const TransRequest<CharT>& request, Fn&& fn) {
+    if (request.args == nullptr) {
+      NoArgsLookup lookup;
+      fn(lookup);
+    } else {
+      TransArgsLookup lookup{*request.args};
+      fn(lookup);
+    }
+  }
+
+  /** Returns the configuration for msgId, or nullptr if its message type isn't configured. */
+  const MsgConfig<CharT>* findConfig(const MsgId<CharT>& msgId) const {
+    if ((msgId.keySetId() == configs_->keySetId()) && (msgId.index() < configs_->size())) {
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+      metrics_.recordHit(msgId.index());
 #endif
+      return &configs_->at(msgId.index());
+    }
+
+    // Not resolved against this set of message types.
+    return findConfig(msgId.msgType());
   }
 
-  static string_type missingArg(basic_string_view<CharT> msgType, basic_string_view<CharT> argKey) {
-#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
-    throw MissingArgException<CharT>{msgType, argKey};
+  /** Returns the configuration for msgType, or nullptr if it isn't configured. */
+  const MsgConfig<CharT>* findConfig(basic_string_view<CharT> msgType) const {
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+    const std::uint32_t index = configs_->indexOf(msgType);
+    if (index == MsgId<CharT>::kUnresolved) {
+      metrics_.recordMissingMsgType(msgType);
+      return nullptr;
+    }
+    metrics_.recordHit(index);
+    return &configs_->at(index);
 #else
-    static_cast<void>(msgType);  // Suppress unreferenced parameter warning.
-    static_cast<void>(argKey);   // Suppress unreferenced parameter warning.
-    return {};
+    return configs_->find(msgType);
 #endif
   }
 
-  string_type substituteArgs(
-      basic_string_view<CharT> msgType, const std::basic_string<CharT>& msg,
-      const TransArgs<CharT>& args) const {
-    // TODO: If needed, could improve efficiency here by reserving capacity
-    // necessary to fit msg and argument values (TransArgs could track sum of lengths).
-    string_type result;
+  /**
+   * Returns the case of config to render for pluralCount (internal::kNoCount
+   * for non-plural translations), or nullptr if there is none.
+   */
+  const PluralCase<CharT>* selectCase(const MsgConfig<CharT>& config, int pluralCount) const {
+    if (config.hasPluralCases() == (pluralCount == internal::kNoCount)) {
+      return nullptr;  // Mismatch between translate() and translatePlural().
+    }
+
+    return (pluralCount == internal::kNoCount)
+               ? &config.onlyCase()
+               : config.findPluralCase(pluralCount, configs_->pluralRules());
+  }
+
+  /**
+   * Computes the rendered size of msgCase into size. Returns false (setting
+   * missingArgKey) if any argument is missing.
+   */
+  template<typename Lookup>
+  static bool measureCase(
+      const PluralCase<CharT>& msgCase, Lookup& lookup, std::size_t& size,
+      basic_string_view<CharT>& missingArgKey) {
+    const basic_string_view<CharT> msg = msgCase.msg();
+    size = 0;
+
+    for (const auto& segment : msgCase.segments()) {
+      if (!segment.isArg()) {
+        size += segment.length;
+        continue;
+      }
 
-    auto start = msg.begin();
-    const auto end = msg.end();
+      const auto argKey = internal::segmentText<CharT>(msg, segment);
+      const basic_string_view<CharT>* value = lookup(segment, argKey);
+      if (value == nullptr) {
+        missingArgKey = argKey;
+        return false;
+      }
+      size += value->size();
+    }
 
-    match_type match;
-    while (std::regex_search(start, end, match, argPattern_)) {
-      const std::basic_string<CharT> argKey = match[1];
+    return true;
+  }
 
-      if (!args.has(argKey)) {
-        return missingArg(msgType, argKey);
+  /**
+   * Selects and measures the case of config (nullptr if not configured) to
+   * render. Returns the error, if any, setting missingArgKey for
+   * TransError::kMissingArg.
+   */
+  template<typename Lookup>
+  TransError tryMeasure(
+      const MsgConfig<CharT>* config, int pluralCount, Lookup& lookup,
+      const PluralCase<CharT>*& msgCase, std::size_t& size,
+      basic_string_view<CharT>& missingArgKey) const {
+    if (config == nullptr) {
+      return TransError::kMissingMsgType;
+    }
+
+    msgCase = selectCase(*config, pluralCount);
+    if (msgCase == nullptr) {
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+      metrics_.recordInvalidArgs();
+#endif
+      return TransError::kInvalidArgs;
+    }
+
+    if (!measureCase(*msgCase, lookup, size, missingArgKey)) {
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+      metrics_.recordMissingArg();
+#endif
+      return TransError::kMissingArg;
+    }
+    return TransError::kNone;
+  }
+
+  template<typename Lookup>
+  std::size_t measure(
+      basic_string_view<CharT> msgType, const MsgConfig<CharT>* config, int pluralCount,
+      Lookup&& lookup) const {
+    const PluralCase<CharT>* msgCase = nullptr;
+    std::size_t size = 0;
+    basic_string_view<CharT> missingArgKey;
+    const TransError error = tryMeasure(config, pluralCount, lookup, msgCase, size, missingArgKey);
+    if (error != TransError::kNone) {
+      fail(error, msgType, missingArgKey);
+      return 0;
+    }
+    return size;
+  }
+
+  /**
+   * Appends the translation to sink, or returns the error (see tryMeasure()).
+   * Errors never leave partial output (except in append-only sinks for
+   * verified configs; see renderVerified()).
+   */
+  template<typename Sink, typename Lookup>
+  TransError tryRender(
+      Sink& sink, const MsgConfig<CharT>* config, int pluralCount, Lookup& lookup,
+      basic_string_view<CharT>& missingArgKey) const {
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+    const std::uint64_t sampleStart = metrics_.startSample();
+#endif
+
+    if (verified_ && (config != nullptr)) {
+      const TransError error = renderVerified(sink, *config, pluralCount, lookup, missingArgKey);
+      if (error != TransError::kNone) {
+        return error;
       }
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+      metrics_.endSample(sampleStart);
+#endif
+      return TransError::kNone;
+    }
 
-      result.append(match.prefix());
-      result.append(std::basic_string<CharT>{args.get(argKey)});
+    // Validate and reserve all space up front, so that errors never leave
+    // partial output.
+    const PluralCase<CharT>* msgCase = nullptr;
+    std::size_t size = 0;
+    const TransError error = tryMeasure(config, pluralCount, lookup, msgCase, size, missingArgKey);
+    if (error != TransError::kNone) {
+      return error;
+    }
+    internal::reserveMore(sink, size, 0);
 
-      start += match.position() + match.length();  // Advance past %{argKey} token.
+    const basic_string_view<CharT> msg = msgCase->msg();
+    for (const auto& segment : msgCase->segments()) {
+      const auto text = internal::segmentText<CharT>(msg, segment);
+      const auto& value = segment.isArg() ? *lookup(segment, text) : text;
+      sink.append(value.data(), value.size());
     }
 
-    // No more arguments matches. Append rest of message.
-    result.append(start, end);
-    return result;
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+    metrics_.endSample(sampleStart);
+#endif
+    return TransError::kNone;
+  }
+
+  /**
+   * Appends the translation of config to sink in a single pass, for verified
+   * configs (see MsgConfigs::markVerified()), or returns the error (see
+   * tryMeasure()). On a missing argument, sink is truncated back to its
+   * original size if it can be.
+   */
+  template<typename Sink, typename Lookup>
+  TransError renderVerified(
+      Sink& sink, const MsgConfig<CharT>& config, int pluralCount, Lookup& lookup,
+      basic_string_view<CharT>& missingArgKey) const {
+    const PluralCase<CharT>* const msgCase = selectCase(config, pluralCount);
+    if (msgCase == nullptr) {
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+      metrics_.recordInvalidArgs();
+#endif
+      return TransError::kInvalidArgs;
+    }
+
+    // Note: The message text (with its %{argKey} tokens) is usually close to
+    // the rendered size, and the sink grows geometrically past it.
+    const basic_string_view<CharT> msg = msgCase->msg();
+    const std::size_t startSize = internal::sinkSize(sink, 0);
+    internal::reserveMore(sink, msg.size(), 0);
+    for (const auto& segment : msgCase->segments()) {
+      const auto text = internal::segmentText<CharT>(msg, segment);
+      if (!segment.isArg()) {
+        sink.append(text.data(), text.size());
+        continue;
+      }
+
+      const basic_string_view<CharT>* value = lookup(segment, text);
+      if (value == nullptr) {
+        internal::truncateTo(sink, startSize, 0);
+        missingArgKey = text;
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+        metrics_.recordMissingArg();
+#endif
+        return TransError::kMissingArg;
+      }
+      sink.append(value->data(), value->size());
+    }
+    return TransError::kNone;
+  }
+
+  /**
+   * Appends the translation to sink. Appends nothing on errors (with
+   * exceptions disabled).
+   */
+  template<typename Sink, typename Lookup>
+  void render(
+      Sink& sink, basic_string_view<CharT> msgType, const MsgConfig<CharT>* config,
+      int pluralCount, Lookup&& lookup) const {
+    basic_string_view<CharT> missingArgKey;
+    const TransError error = tryRender(sink, config, pluralCount, lookup, missingArgKey);
+    if (error != TransError::kNone) {
+      fail(error, msgType, missingArgKey);
+    }
+  }
+
+  /** Returns a TransResult with the translation, or the error. */
+  template<typename Lookup>
+  TransResult<CharT> tryRenderResult(
+      basic_string_view<CharT> msgType, const MsgConfig<CharT>* config, int pluralCount,
+      Lookup&& lookup) const {
+    string_type result;
+    basic_string_view<CharT> missingArgKey;
+    const TransError error = tryRender(result, config, pluralCount, lookup, missingArgKey);
+    if (error != TransError::kNone) {
+      return TransResult<CharT>{error, msgType, missingArgKey};
+    }
+    return TransResult<CharT>{std::move(result)};
+  }
+
+  /** Throws the exception for error (if exceptions are enabled). */
+  static void fail(
+      TransError error, basic_string_view<CharT> msgType, basic_string_view<CharT> argKey) {
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+    switch (error) {
+      case TransError::kMissingMsgType:
+        throw MissingMsgTypeException<CharT>{msgType};
+      case TransError::kMissingArg:
+        throw MissingArgException<CharT>{msgType, argKey};
+      default:
+        throw InvalidArgsException<CharT>{msgType};
+    }
+#else
+    static_cast<void>(error);    // Suppress unreferenced parameter warning.
+    static_cast<void>(msgType);  // Suppress unreferenced parameter warning.
+    static_cast<void>(argKey);   // Suppress unreferenced parameter warning.
+#endif
   }
 
   std::unique_ptr<MsgConfigs<CharT>> configs_;
-  const std::basic_regex<CharT> argPattern_ = internal::argPattern<CharT>();
+  bool verified_ = false;  // Whether configs_ were verified (rendering without measuring).
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  mutable internal::MetricsRecorder<CharT> metrics_;
+#endif
 };
 
 }  // namespace simple_tr8n
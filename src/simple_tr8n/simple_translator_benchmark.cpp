@@ -0,0 +1,468 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/simple_translator.hpp"
+#include "simple_tr8n/static_translator.hpp"
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  #include "simple_tr8n/exceptions.hpp"
+#endif
+
+#ifdef __has_include
+  #if __has_include(<memory_resource>)
+    #include <memory_resource>
+  #endif
+#endif
+
+// Counts heap allocations made by each thread, to report allocations per call.
+namespace {
+
+thread_local std::size_t numAllocs = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++numAllocs;
+  void* const ptr = std::malloc((size > 0) ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+// Note: GCC 11+ warns about free() on pointers from operator new once these
+// replacements are inlined, which is a false positive here.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+constexpr std::size_t kNumMsgs = 1000;
+
+template<typename CharT>
+std::basic_string<CharT> widen(const std::string& str) {
+  return std::basic_string<CharT>(str.begin(), str.end());
+}
+
+template<typename CharT>
+std::basic_string<CharT> msgType(std::size_t i) {
+  return widen<CharT>("your_project.some.long.namespace.messages.msg_" + std::to_string(i));
+}
+
+template<typename CharT>
+std::basic_string<CharT> argKey(std::size_t i) {
+  return widen<CharT>("arg" + std::to_string(i));
+}
+
+/** Message with numArgs distinct arguments, e.g. "Args: %{arg0}, %{arg1}.". */
+template<typename CharT>
+std::basic_string<CharT> argsMsg(std::size_t numArgs) {
+  std::string msg = "Args:";
+  for (std::size_t i = 0; i < numArgs; ++i) {
+    msg += " %{arg" + std::to_string(i) + "},";
+  }
+  msg += " done.";
+  return widen<CharT>(msg);
+}
+
+/**
+ * Catalog of numMsgs messages: msg_i has (i % 17) arguments, so messages with
+ * 0-16 arguments are all present. Optionally marked verified (skipping
+ * per-call checks).
+ */
+template<typename CharT>
+std::unique_ptr<simple_tr8n::SimpleTranslator<CharT>> makeTranslator(
+    std::size_t numMsgs, bool verified = false) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<CharT>>();
+  for (std::size_t i = 0; i < numMsgs; ++i) {
+    configs->add(msgType<CharT>(i), argsMsg<CharT>(i % 17));
+  }
+  if (verified) {
+    configs->freeze();
+    configs->markVerified();
+  }
+  return std::make_unique<simple_tr8n::SimpleTranslator<CharT>>(std::move(configs));
+}
+
+/** Reports average allocations per iteration (summed across threads). */
+void reportAllocs(benchmark::State& state, std::size_t allocsBefore) {
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(numAllocs - allocsBefore), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Message with no arguments, looked up in catalogs of varying size (in a
+// shuffled order, so lookups aren't all cache hits).
+template<typename CharT>
+void BM_Translate(benchmark::State& state) {
+  const auto numMsgs = static_cast<std::size_t>(state.range(0));
+  const auto translator = makeTranslator<CharT>(numMsgs);
+
+  std::vector<std::basic_string<CharT>> types;
+  for (std::size_t i = 0; i < numMsgs; i += 17) {
+    types.push_back(msgType<CharT>(i));
+  }
+  std::shuffle(types.begin(), types.end(), std::mt19937{42});
+
+  std::size_t i = 0;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(translator->translate(types[i]));
+    i = (i + 1 < types.size()) ? i + 1 : 0;
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_Translate, char)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK_TEMPLATE(BM_Translate, wchar_t)->RangeMultiplier(10)->Range(100, 100000);
+
+// Message with the given number of arguments, including building TransArgs.
+template<typename CharT>
+void BM_TranslateArgs(benchmark::State& state) {
+  const auto numArgs = static_cast<std::size_t>(state.range(0));
+  const auto translator = makeTranslator<CharT>(kNumMsgs);
+  const auto type = msgType<CharT>(numArgs);
+
+  std::vector<std::basic_string<CharT>> keys;
+  for (std::size_t i = 0; i < numArgs; ++i) {
+    keys.push_back(argKey<CharT>(i));
+  }
+  const auto value = widen<CharT>("value");
+
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    simple_tr8n::TransArgs<CharT> args;
+    for (const auto& key : keys) {
+      args.add(key, value);
+    }
+    benchmark::DoNotOptimize(translator->translate(type, args));
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslateArgs, char)->DenseRange(0, 4)->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(BM_TranslateArgs, wchar_t)->DenseRange(0, 4)->Arg(8)->Arg(16);
+
+// Same as BM_TranslateArgs (for char), with checked or verified rendering.
+template<bool Verified>
+void BM_TranslateVerified(benchmark::State& state) {
+  const auto numArgs = static_cast<std::size_t>(state.range(0));
+  const auto translator = makeTranslator<char>(kNumMsgs, Verified);
+  const auto type = msgType<char>(numArgs);
+
+  simple_tr8n::TransArgs<char> args;
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < numArgs; ++i) {
+    keys.push_back(argKey<char>(i));
+  }
+  for (const auto& key : keys) {
+    args.add(key, "value");
+  }
+
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(translator->translate(type, args));
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslateVerified, false)->Arg(0)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_TranslateVerified, true)->Arg(0)->Arg(4)->Arg(16);
+
+// Same as BM_TranslateArgs, but appending to a reused buffer.
+template<typename CharT>
+void BM_TranslateArgsTo(benchmark::State& state) {
+  const auto numArgs = static_cast<std::size_t>(state.range(0));
+  const auto translator = makeTranslator<CharT>(kNumMsgs);
+  const auto type = msgType<CharT>(numArgs);
+
+  std::vector<std::basic_string<CharT>> keys;
+  for (std::size_t i = 0; i < numArgs; ++i) {
+    keys.push_back(argKey<CharT>(i));
+  }
+  const auto value = widen<CharT>("value");
+  std::basic_string<CharT> out;
+
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    simple_tr8n::TransArgs<CharT> args;
+    for (const auto& key : keys) {
+      args.add(key, value);
+    }
+    out.clear();
+    translator->translateTo(out, type, args);
+    benchmark::DoNotOptimize(out.data());
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslateArgsTo, char)->Arg(0)->Arg(4)->Arg(16);
+
+/** Formats value with std::to_string() or std::to_wstring(). */
+template<typename CharT, typename T>
+std::basic_string<CharT> toString(T value);
+
+template<>
+std::string toString<char>(std::int64_t value) {
+  return std::to_string(value);
+}
+
+template<>
+std::string toString<char>(double value) {
+  return std::to_string(value);
+}
+
+template<>
+std::wstring toString<wchar_t>(std::int64_t value) {
+  return std::to_wstring(value);
+}
+
+template<>
+std::wstring toString<wchar_t>(double value) {
+  return std::to_wstring(value);
+}
+
+// Message with an integer and a floating-point argument, either formatted into
+// temporary strings by the caller (Typed = false) or passed to TransArgs as
+// numbers (Typed = true).
+template<typename CharT, bool Typed>
+void BM_TranslateNumberArgs(benchmark::State& state) {
+  const auto translator = makeTranslator<CharT>(kNumMsgs);
+  const auto type = msgType<CharT>(2);
+  const auto key0 = argKey<CharT>(0);
+  const auto key1 = argKey<CharT>(1);
+
+  std::int64_t count = 1000000;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    const double price = static_cast<double>(count) * 0.25;
+    if (Typed) {
+      benchmark::DoNotOptimize(translator->translate(type, {{key0, count}, {key1, price}}));
+    } else {
+      const auto countStr = toString<CharT>(count);
+      const auto priceStr = toString<CharT>(price);
+      benchmark::DoNotOptimize(translator->translate(type, {{key0, countStr}, {key1, priceStr}}));
+    }
+    ++count;
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslateNumberArgs, char, false);
+BENCHMARK_TEMPLATE(BM_TranslateNumberArgs, char, true);
+BENCHMARK_TEMPLATE(BM_TranslateNumberArgs, wchar_t, false);
+BENCHMARK_TEMPLATE(BM_TranslateNumberArgs, wchar_t, true);
+
+// Plural message with the given number of cases, cycling through counts that
+// select each case.
+template<typename CharT>
+void BM_TranslatePlural(benchmark::State& state) {
+  const auto numCases = static_cast<int>(state.range(0));
+  const auto type = widen<CharT>("your_project.messages.num_files");
+
+  std::vector<simple_tr8n::PluralCase<CharT>> cases;
+  for (int count = 0; count < numCases; ++count) {
+    cases.emplace_back(count, widen<CharT>("Case " + std::to_string(count) + ": %{num} files"));
+  }
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<CharT>>();
+  configs->add(type, std::move(cases));
+  const simple_tr8n::SimpleTranslator<CharT> translator{std::move(configs)};
+
+  const auto numKey = widen<CharT>("num");
+  const auto numValue = widen<CharT>("42");
+
+  int count = 0;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(translator.translatePlural(type, count, {{numKey, numValue}}));
+    count = (count + 1 < numCases) ? count + 1 : 0;
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslatePlural, char)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK_TEMPLATE(BM_TranslatePlural, wchar_t)->RangeMultiplier(2)->Range(1, 8);
+
+// A page's worth of messages (with 0-2 arguments), rendered one call at a time
+// or as one batch.
+template<bool Batch>
+void BM_TranslatePage(benchmark::State& state) {
+  const auto numRequests = static_cast<std::size_t>(state.range(0));
+  const auto translator = makeTranslator<char>(100000);
+
+  std::vector<std::string> types;
+  for (std::size_t i = 0; i < numRequests; ++i) {
+    types.push_back(msgType<char>((i * 7919 % 5882) * 17 + i % 3));
+  }
+  const simple_tr8n::TransArgs<char> args{{"arg0", "value"}, {"arg1", "value"}};
+  std::vector<simple_tr8n::TransRequest<char>> requests;
+  for (const auto& type : types) {
+    requests.push_back(simple_tr8n::TransRequest<char>{type, &args});
+  }
+
+  std::string out;
+  std::vector<std::size_t> offsets;
+  const simple_tr8n::Translator<char>& api = *translator;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    if (Batch) {
+      api.translateBatch(requests, out, offsets);
+      benchmark::DoNotOptimize(out.data());
+    } else {
+      for (const auto& type : types) {
+        benchmark::DoNotOptimize(api.translate(type, args));
+      }
+    }
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslatePage, false)->Arg(50)->Arg(200);
+BENCHMARK_TEMPLATE(BM_TranslatePage, true)->Arg(50)->Arg(200);
+
+// Short messages appended to a reused buffer, through the virtual Translator
+// interface or a StaticTranslator (which the compiler can inline).
+template<bool Static>
+void BM_TranslateDispatch(benchmark::State& state) {
+  const auto translator = makeTranslator<char>(kNumMsgs);
+  std::vector<std::string> types;
+  for (std::size_t i = 1; i < kNumMsgs; i += 17) {
+    types.push_back(msgType<char>(i));  // Each with 1 argument.
+  }
+  const simple_tr8n::TransArgs<char> args{{"arg0", "value"}};
+
+  // Note: Hides the concrete type from the compiler, as for a translator
+  // configured elsewhere.
+  const simple_tr8n::Translator<char>* api = translator.get();
+  benchmark::DoNotOptimize(api);
+  const auto facade = simple_tr8n::makeStaticTranslator(*translator);
+
+  std::string out;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    out.clear();
+    for (const auto& type : types) {
+      if (Static) {
+        facade.translateTo(out, type, args);
+      } else {
+        api->translateTo(out, type, args);
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  reportAllocs(state, allocsBefore);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(types.size()));
+}
+BENCHMARK_TEMPLATE(BM_TranslateDispatch, false);
+BENCHMARK_TEMPLATE(BM_TranslateDispatch, true);
+
+// Message type missing from the catalog (as during a rollout), reported by
+// translate() throwing (if exceptions are enabled) or by tryTranslate().
+template<bool Try>
+void BM_TranslateMissing(benchmark::State& state) {
+  const auto translator = makeTranslator<char>(kNumMsgs);
+  const std::string type = "your_project.messages.not_added_yet";
+
+  std::size_t numErrors = 0;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    if (Try) {
+      numErrors += translator->tryTranslate(type).ok() ? 0 : 1;
+      continue;
+    }
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+    try {
+      benchmark::DoNotOptimize(translator->translate(type));
+    } catch (const simple_tr8n::MissingMsgTypeException<char>&) {
+      ++numErrors;
+    }
+#else
+    numErrors += translator->translate(type).empty() ? 1 : 0;
+#endif
+  }
+  benchmark::DoNotOptimize(numErrors);
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK_TEMPLATE(BM_TranslateMissing, false);
+BENCHMARK_TEMPLATE(BM_TranslateMissing, true);
+
+// Shared by all benchmark threads (set up by thread 0 before its loop starts,
+// which happens before any thread's loop starts).
+std::unique_ptr<simple_tr8n::SimpleTranslator<char>> sharedTranslator;
+
+// Throughput of one translator shared by several threads, each translating a
+// different message.
+void BM_TranslateThreaded(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    sharedTranslator = makeTranslator<char>(kNumMsgs);
+  }
+
+  const auto type = msgType<char>(static_cast<std::size_t>(state.thread_index()) * 17 + 2);
+  // Note: Not dereferenced until the loop starts, after thread 0 sets it up.
+  const auto& translator = sharedTranslator;
+
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(translator->translate(type, {{"arg0", "value"}, {"arg1", "value"}}));
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK(BM_TranslateThreaded)->ThreadRange(1, 8)->UseRealTime();
+
+#ifdef __cpp_lib_memory_resource
+
+// Same as BM_TranslateThreaded, but each thread renders into a request-scoped
+// arena (released after every kRequestSize translations), so translating never
+// touches the global allocator.
+void BM_TranslateThreadedArena(benchmark::State& state) {
+  constexpr std::size_t kRequestSize = 64;
+  if (state.thread_index() == 0) {
+    sharedTranslator = makeTranslator<char>(kNumMsgs);
+  }
+
+  const auto type = msgType<char>(static_cast<std::size_t>(state.thread_index()) * 17 + 2);
+  const auto& translator = sharedTranslator;
+
+  std::array<char, 8192> buffer;
+  std::pmr::monotonic_buffer_resource arena{
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+  const std::pmr::polymorphic_allocator<char> alloc{&arena};
+
+  std::size_t numInRequest = 0;
+  const std::size_t allocsBefore = numAllocs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(translator->translate(
+        std::allocator_arg, alloc, type, {{"arg0", "value"}, {"arg1", "value"}}));
+    if (++numInRequest == kRequestSize) {
+      arena.release();
+      numInRequest = 0;
+    }
+  }
+  reportAllocs(state, allocsBefore);
+}
+BENCHMARK(BM_TranslateThreadedArena)->ThreadRange(1, 8)->UseRealTime();
+
+#endif  // __cpp_lib_memory_resource
+
+}  // namespace
@@ -5,7 +5,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "simple_tr8n/simple_translator.hpp"
 #include "simple_tr8n/translator.hpp"
@@ -29,7 +34,10 @@ constexpr char kAddlMsg[] = "test2.addl";
 
 }  // namespace test_msgs2
 
+using ::testing::ElementsAre;
 using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Ne;
 using ::testing::StrEq;
 using ::testing::Test;
 
@@ -186,8 +194,244 @@ TEST_F(SimpleTranslatorCharTest, ShouldTranslatePlural) {
       Eq("Alice y Bob, tienen 102 peces"));
 }
 
+namespace {
+
+// Minimal output sink, with no reserve() support.
+struct CharVectorSink {
+  void append(const char* data, std::size_t size) { chars.insert(chars.end(), data, data + size); }
+  std::vector<char> chars;
+};
+
+}  // namespace
+
+TEST_F(SimpleTranslatorCharTest, ShouldTranslatePluralFromCountArg) {
+  const simple_tr8n::TransArgs<char> args{
+      {"person1Name", "Alice"}, {"person2Name", "Bob"}, {"fishCount", 1}};
+  EXPECT_THAT(
+      enTranslator->translatePlural(test_msgs::kCoupleFishCount, "fishCount", args),
+      Eq("Alice and Bob, you have a fish"));
+  EXPECT_THAT(
+      esTranslator->translatePlural(
+          esTranslator->resolve(test_msgs::kCoupleFishCount), "fishCount",
+          {{"person1Name", "Alice"}, {"person2Name", "Bob"}, {"fishCount", 12}}),
+      Eq("Alice y Bob, tienen 12 peces"));
+
+  const simple_tr8n::Translator<char>& translator = *enTranslator;
+  EXPECT_THAT(
+      translator.translatePlural(
+          test_msgs::kCoupleFishCount, "fishCount",
+          {{"person1Name", "Alice"}, {"person2Name", "Bob"}, {"fishCount", 5u}}),
+      Eq("Alice and Bob, you have 5 fish"));
+}
+
+TEST_F(SimpleTranslatorCharTest, ShouldAppendTranslations) {
+  std::string out = "> ";
+  enTranslator->translateTo(out, test_msgs::kNoArgs);
+  out.append(" | ");
+  enTranslator->translateTo(out, test_msgs::kHelloName, {{"personName", "Bob"}});
+  out.append(" | ");
+  esTranslator->translatePluralTo(
+      out, test_msgs::kCoupleFishCount, 1, {{"person1Name", "Alice"}, {"person2Name", "Bob"}});
+  EXPECT_THAT(
+      out, Eq("> A simple message with no arguments | hello, Bob! | Alice y Bob, tienen un pez"));
+
+  // Reusing capacity:
+  out.clear();
+  const auto capacity = out.capacity();
+  enTranslator->translateTo(out, test_msgs::kHelloName, {{"personName", "Alice"}});
+  EXPECT_THAT(out, Eq("hello, Alice!"));
+  EXPECT_THAT(out.capacity(), Eq(capacity));
+
+  // Through the Translator interface:
+  const simple_tr8n::Translator<char>& translator = *esTranslator;
+  translator.translateTo(out, test_msgs::kProgressPct, {{"pct", "75"}});
+  EXPECT_THAT(out, Eq("hello, Alice!progreso: 75%"));
+}
+
+TEST_F(SimpleTranslatorCharTest, ShouldAppendTranslationsToAnySink) {
+  CharVectorSink sink;
+  enTranslator->translateTo(sink, test_msgs::kProgressPct, {{"pct", "75"}});
+  enTranslator->translatePluralTo(
+      sink, test_msgs::kCoupleFishCount, 3,
+      {{"person1Name", "Alice"}, {"person2Name", "Bob"}, {"fishCount", "3"}});
+  EXPECT_THAT(
+      std::string(sink.chars.begin(), sink.chars.end()),
+      Eq("progress: 75%Alice and Bob, you have 3 fish"));
+}
+
+TEST_F(SimpleTranslatorCharTest, ShouldComputeRenderedSize) {
+  EXPECT_THAT(
+      enTranslator->renderedSize(test_msgs::kNoArgs),
+      Eq(enTranslator->translate(test_msgs::kNoArgs).size()));
+
+  const simple_tr8n::TransArgs<char> args{{"personName", "Bartholomew"}};
+  EXPECT_THAT(
+      enTranslator->renderedSize(test_msgs::kHelloName, args),
+      Eq(enTranslator->translate(test_msgs::kHelloName, args).size()));
+
+  const simple_tr8n::TransArgs<char> pluralArgs{
+      {"person1Name", "Alice"}, {"person2Name", "Bob"}, {"fishCount", "102"}};
+  EXPECT_THAT(
+      esTranslator->renderedPluralSize(test_msgs::kCoupleFishCount, 102, pluralArgs),
+      Eq(esTranslator->translatePlural(test_msgs::kCoupleFishCount, 102, pluralArgs).size()));
+}
+
+TEST_F(SimpleTranslatorCharTest, ShouldTranslateResolvedMsgIds) {
+  const auto noArgs = enTranslator->resolve(test_msgs::kNoArgs);
+  const auto helloName = enTranslator->resolve(test_msgs::kHelloName);
+  const auto coupleFishCount = enTranslator->resolve(test_msgs::kCoupleFishCount);
+  EXPECT_THAT(noArgs.index(), Ne(simple_tr8n::MsgId<char>::kUnresolved));
+
+  EXPECT_THAT(enTranslator->translate(noArgs), Eq("A simple message with no arguments"));
+  EXPECT_THAT(enTranslator->translate(helloName, {{"personName", "Bob"}}), Eq("hello, Bob!"));
+  EXPECT_THAT(
+      enTranslator->translatePlural(
+          coupleFishCount, 1,
+          {
+              {"person1Name", "Alice"},
+              {"person2Name", "Bob"},
+          }),
+      Eq("Alice and Bob, you have a fish"));
+
+  // Handles stay valid across locales with the same set of message types:
+  EXPECT_THAT(esTranslator->resolve(test_msgs::kHelloName).index(), Eq(helloName.index()));
+  EXPECT_THAT(esTranslator->translate(noArgs), Eq("Un mensaje simple sin argumentos"));
+  EXPECT_THAT(esTranslator->translate(helloName, {{"personName", "Bob"}}), Eq("hola, Bob!"));
+
+  // And still work (by message type lookup) with a different set:
+  auto otherConfig = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  otherConfig->add(test_msgs::kHelloName, "hi, %{personName}!");
+  simple_tr8n::SimpleTranslator<char> otherTranslator{std::move(otherConfig)};
+  EXPECT_THAT(otherTranslator.translate(helloName, {{"personName", "Bob"}}), Eq("hi, Bob!"));
+}
+
+namespace {
+
+/** Splits translateBatch() output into its translations. */
+std::vector<std::string> splitBatch(
+    const std::string& out, const std::vector<std::size_t>& offsets) {
+  std::vector<std::string> result;
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    result.push_back(out.substr(offsets[i], offsets[i + 1] - offsets[i]));
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_F(SimpleTranslatorCharTest, ShouldTranslateBatch) {
+  const simple_tr8n::TransArgs<char> helloArgs{{"personName", "Bob"}};
+  const simple_tr8n::TransArgs<char> fishArgs{
+      {"person1Name", "Alice"}, {"person2Name", "Bob"}, {"fishCount", "5"}};
+  const simple_tr8n::TransArgs<char> addlArgs{{"arg", "x"}};
+  const std::vector<simple_tr8n::TransRequest<char>> requests = {
+      {test_msgs2::kAddlMsg, &addlArgs},
+      {test_msgs::kHelloName, &helloArgs},
+      {test_msgs::kNoArgs},
+      {test_msgs::kCoupleFishCount, &fishArgs, 5},
+      {test_msgs::kHelloName, &helloArgs},
+  };
+
+  std::string out = "old";
+  std::vector<std::size_t> offsets = {7};
+  const simple_tr8n::Translator<char>& translator = *enTranslator;
+  translator.translateBatch(requests, out, offsets);
+
+  EXPECT_THAT(offsets.size(), Eq(requests.size() + 1));
+  EXPECT_THAT(offsets.back(), Eq(out.size()));
+  EXPECT_THAT(
+      splitBatch(out, offsets),
+      ElementsAre(
+          "An additional message with x", "hello, Bob!", "A simple message with no arguments",
+          "Alice and Bob, you have 5 fish", "hello, Bob!"));
+
+  translator.translateBatch({}, out, offsets);
+  EXPECT_THAT(out, Eq(""));
+  EXPECT_THAT(offsets, ElementsAre(0u));
+}
+
+// Same in both build modes.
+TEST_F(SimpleTranslatorCharTest, ShouldReturnTryTranslateErrors) {
+  using simple_tr8n::TransError;
+
+  const auto hello = enTranslator->tryTranslate(test_msgs::kHelloName, {{"personName", "Bob"}});
+  ASSERT_TRUE(hello.ok());
+  EXPECT_THAT(hello.error(), Eq(TransError::kNone));
+  EXPECT_THAT(hello.value(), Eq("hello, Bob!"));
+  EXPECT_THAT(
+      esTranslator->tryTranslatePlural(test_msgs::kCoupleFishCount, 1, {{"person1Name", "Ana"}})
+          .valueOr("?"),
+      Eq("?"));
+
+  const auto missingType = enTranslator->tryTranslate("test.missing");
+  EXPECT_FALSE(missingType);
+  EXPECT_THAT(missingType.error(), Eq(TransError::kMissingMsgType));
+  EXPECT_THAT(missingType.msgType(), Eq("test.missing"));
+  EXPECT_THAT(missingType.argKey(), Eq(""));
+  EXPECT_THAT(missingType.valueOr("fallback"), Eq("fallback"));
+
+  const auto missingArg = enTranslator->tryTranslate(test_msgs::kHelloName, {{"name", "Bob"}});
+  EXPECT_THAT(missingArg.error(), Eq(TransError::kMissingArg));
+  EXPECT_THAT(missingArg.msgType(), Eq(test_msgs::kHelloName));
+  EXPECT_THAT(missingArg.argKey(), Eq("personName"));
+
+  EXPECT_THAT(
+      enTranslator->tryTranslate(test_msgs::kCoupleFishCount).error(),
+      Eq(TransError::kInvalidArgs));
+  EXPECT_THAT(
+      enTranslator->tryTranslatePlural(test_msgs::kNoArgs, 1, {}).error(),
+      Eq(TransError::kInvalidArgs));
+  EXPECT_THAT(
+      esTranslator->tryTranslatePlural(test_msgs::kCoupleFishCount, 0, {}).error(),
+      Eq(TransError::kInvalidArgs));
+
+  const auto noArgs = enTranslator->resolve(test_msgs::kNoArgs);
+  EXPECT_THAT(
+      esTranslator->tryTranslate(noArgs).value(), Eq("Un mensaje simple sin argumentos"));
+  const auto missingId = enTranslator->tryTranslate(simple_tr8n::MsgId<char>{"test.missing"});
+  EXPECT_THAT(missingId.error(), Eq(TransError::kMissingMsgType));
+  EXPECT_THAT(missingId.msgType(), Eq("test.missing"));
+}
+
 #ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
 
+TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsMsgIds) {
+  // Missing message type (only reported once translated):
+  const auto notConfigured = enTranslator->resolve("not.configured_msg_type");
+  EXPECT_THAT(notConfigured.index(), Eq(simple_tr8n::MsgId<char>::kUnresolved));
+  try {
+    enTranslator->translate(notConfigured);
+    FAIL() << "Expecting MissingMsgTypeException";
+  } catch (const simple_tr8n::MissingMsgTypeException<char>& e) {
+    EXPECT_THAT(e.what(), StrEq("simple_tr8n::MissingMsgTypeException: not.configured_msg_type"));
+  }
+
+  // Plural mismatch:
+  try {
+    enTranslator->translatePlural(
+        enTranslator->resolve(test_msgs::kHelloName), 1, {{"personName", "Alice"}});
+    FAIL() << "Expecting InvalidArgsException";
+  } catch (const simple_tr8n::InvalidArgsException<char>& e) {
+    EXPECT_THAT(e.what(), StrEq("simple_tr8n::InvalidArgsException: test.hello_name"));
+  }
+}
+
+TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsAppending) {
+  std::string out = "unchanged";
+
+  // Missing argument (after a substituted one):
+  EXPECT_THROW(
+      enTranslator->translatePluralTo(
+          out, test_msgs::kCoupleFishCount, 2, {{"person1Name", "Alice"}, {"fishCount", "2"}}),
+      simple_tr8n::MissingArgException<char>);
+  EXPECT_THROW(
+      enTranslator->renderedPluralSize(
+          test_msgs::kCoupleFishCount, 2, {{"person1Name", "Alice"}, {"fishCount", "2"}}),
+      simple_tr8n::MissingArgException<char>);
+
+  EXPECT_THAT(out, Eq("unchanged"));
+}
+
 TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsNoArgs) {
   // Missing message type:
   try {
@@ -296,10 +540,55 @@ TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsPlural) {
   }
 }
 
+TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsBatch) {
+  const std::vector<simple_tr8n::TransRequest<char>> requests = {
+      {test_msgs::kNoArgs},
+      {test_msgs::kHelloName},  // Missing argument.
+  };
+
+  std::string out;
+  std::vector<std::size_t> offsets;
+  EXPECT_THROW(
+      enTranslator->translateBatch(requests, out, offsets),
+      simple_tr8n::MissingArgException<char>);
+}
+
 #else  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
 
 // With exceptions disabled, all errors should just yield the empty string:
 
+TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsMsgIds) {
+  // Missing message type:
+  EXPECT_THAT(enTranslator->translate(enTranslator->resolve("not.configured_msg_type")), Eq(""));
+
+  // Plural mismatch:
+  EXPECT_THAT(
+      enTranslator->translatePlural(
+          enTranslator->resolve(test_msgs::kHelloName), 1, {{"personName", "Alice"}}),
+      Eq(""));
+}
+
+TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsAppending) {
+  std::string out = "unchanged";
+
+  // Missing message type:
+  enTranslator->translateTo(out, "not.configured_msg_type");
+  EXPECT_THAT(enTranslator->renderedSize("not.configured_msg_type"), Eq(0u));
+
+  // Plural mismatch:
+  enTranslator->translatePluralTo(out, test_msgs::kHelloName, 1, {{"personName", "Alice"}});
+
+  // Missing argument (after a substituted one):
+  enTranslator->translatePluralTo(
+      out, test_msgs::kCoupleFishCount, 2, {{"person1Name", "Alice"}, {"fishCount", "2"}});
+  EXPECT_THAT(
+      enTranslator->renderedPluralSize(
+          test_msgs::kCoupleFishCount, 2, {{"person1Name", "Alice"}, {"fishCount", "2"}}),
+      Eq(0u));
+
+  EXPECT_THAT(out, Eq("unchanged"));
+}
+
 TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsNoArgs) {
   // Missing message type:
   EXPECT_THAT(enTranslator->translate("not.configured_msg_type"), Eq(""));
@@ -363,8 +652,169 @@ TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsPlural) {
       Eq(""));
 }
 
+TEST_F(SimpleTranslatorCharTest, ShouldHandleErrorsBatch) {
+  const std::vector<simple_tr8n::TransRequest<char>> requests = {
+      {test_msgs::kNoArgs},
+      {test_msgs::kHelloName},  // Missing argument.
+      {"not.configured_msg_type"},
+      {test_msgs::kNoArgs, nullptr, 1},  // Plural mismatch.
+      {test_msgs::kNoArgs},
+  };
+
+  std::string out;
+  std::vector<std::size_t> offsets;
+  enTranslator->translateBatch(requests, out, offsets);
+  EXPECT_THAT(
+      splitBatch(out, offsets),
+      ElementsAre(
+          "A simple message with no arguments", "", "", "",
+          "A simple message with no arguments"));
+}
+
 #endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
 
+TEST(MsgConfigsTest, ShouldGetSameConfigsOnceFrozen) {
+  simple_tr8n::MsgConfigs<char> configs;
+  configs.add(test_msgs::kNoArgs, "A simple message with no arguments")
+      .add(test_msgs::kHelloName, "hello, %{personName}!")
+      .add(test_msgs2::kAddlMsg, "An additional message with %{arg}");
+  EXPECT_FALSE(configs.frozen());
+  EXPECT_THAT(configs.size(), Eq(3u));
+  EXPECT_THAT(configs.get(test_msgs::kHelloName).onlyCase().msg(), Eq("hello, %{personName}!"));
+
+  configs.freeze();
+  EXPECT_TRUE(configs.frozen());
+  EXPECT_THAT(configs.size(), Eq(3u));
+  EXPECT_THAT(
+      configs.get(test_msgs::kNoArgs).onlyCase().msg(), Eq("A simple message with no arguments"));
+  EXPECT_THAT(configs.get(test_msgs::kHelloName).onlyCase().msg(), Eq("hello, %{personName}!"));
+  EXPECT_THAT(
+      configs.get(test_msgs2::kAddlMsg).onlyCase().msg(), Eq("An additional message with %{arg}"));
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+  EXPECT_THROW(configs.get("test.hello_nam"), simple_tr8n::MissingMsgTypeException<char>);
+#else
+  EXPECT_THAT(configs.get("test.hello_nam").onlyCase().msg(), Eq(""));
+#endif
+}
+
+TEST(MsgConfigsTest, ShouldPackFrozenTextContiguously) {
+  simple_tr8n::MsgConfigs<char> configs;
+  configs.add(test_msgs::kNoArgs, "A simple message with no arguments")
+      .add(test_msgs::kHelloName, "hello, %{personName}!")
+      .add(
+          test_msgs::kCoupleFishCount,
+          {
+              {1, "%{person1Name} has a fish"},
+              {2, "%{person1Name} has %{fishCount} fish"},
+          });
+  configs.freeze();
+
+  const std::vector<simple_tr8n::basic_string_view<char>> msgs = {
+      configs.get(test_msgs::kNoArgs).onlyCase().msg(),
+      configs.get(test_msgs::kHelloName).onlyCase().msg(),
+      configs.get(test_msgs::kCoupleFishCount).pluralCase(test_msgs::kCoupleFishCount, 1)->msg(),
+      configs.get(test_msgs::kCoupleFishCount).pluralCase(test_msgs::kCoupleFishCount, 5)->msg(),
+  };
+  EXPECT_THAT(msgs[2], Eq("%{person1Name} has a fish"));
+  EXPECT_THAT(msgs[3], Eq("%{person1Name} has %{fishCount} fish"));
+
+  // All message types and texts share one buffer.
+  std::size_t totalSize = sizeof(test_msgs::kNoArgs) + sizeof(test_msgs::kHelloName)
+      + sizeof(test_msgs::kCoupleFishCount) - 3;
+  const char* begin = msgs[0].data();
+  const char* end = msgs[0].data() + msgs[0].size();
+  for (const auto msg : msgs) {
+    totalSize += msg.size();
+    begin = std::min(begin, msg.data());
+    end = std::max(end, msg.data() + msg.size());
+  }
+  EXPECT_THAT(static_cast<std::size_t>(end - begin), Le(totalSize));
+}
+
+TEST(MsgConfigsTest, ShouldStoreHashOnlyKeys) {
+  for (const auto keyStorage :
+       {simple_tr8n::KeyStorage::kHashOnly, simple_tr8n::KeyStorage::kHashOnlyDebug}) {
+    auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+    configs->setKeyStorage(keyStorage)
+        .add(test_msgs::kNoArgs, "A simple message with no arguments")
+        .add(test_msgs::kHelloName, "hello, %{personName}!");
+    auto pool = std::make_shared<simple_tr8n::StringPool<char>>();
+    configs->freeze(pool);
+    EXPECT_THAT(configs->keyStorage(), Eq(keyStorage));
+
+    EXPECT_TRUE(configs->has(test_msgs::kNoArgs));
+    EXPECT_FALSE(configs->has("test.hello_nam"));
+    EXPECT_THAT(configs->find("test.hello_nam"), Eq(nullptr));
+
+    const std::uint32_t index = configs->indexOf(test_msgs::kHelloName);
+    ASSERT_THAT(index, Ne(simple_tr8n::MsgId<char>::kUnresolved));
+    EXPECT_THAT(configs->at(index).onlyCase().msg(), Eq("hello, %{personName}!"));
+
+    // Message types are only kept (and pooled) in the debug side table.
+    const bool keepsKeys = (keyStorage == simple_tr8n::KeyStorage::kHashOnlyDebug);
+    EXPECT_THAT(configs->msgTypeAt(index), Eq(keepsKeys ? test_msgs::kHelloName : ""));
+    EXPECT_THAT(pool->stats().numStrings, Eq(keepsKeys ? 4U : 2U));
+
+    const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+    EXPECT_THAT(
+        translator.translate(test_msgs::kHelloName, {{"personName", "Bob"}}), Eq("hello, Bob!"));
+    EXPECT_THAT(
+        translator.tryTranslate("test.hello_nam").error(),
+        Eq(simple_tr8n::TransError::kMissingMsgType));
+  }
+}
+
+TEST(MsgConfigsTest, ShouldAssignArgSlotsAcrossCases) {
+  simple_tr8n::MsgConfigs<char> configs;
+  configs.add(test_msgs::kHelloName, "%{a}, %{b} and %{a}")
+      .add(
+          test_msgs::kCoupleFishCount,
+          {
+              {1, "%{person1Name} has a fish"},
+              {2, "%{person2Name} and %{person1Name} have %{fishCount} fish"},
+          });
+
+  const auto& helloCase = configs.get(test_msgs::kHelloName).onlyCase();
+  EXPECT_THAT(configs.get(test_msgs::kHelloName).numSlots(), Eq(2u));
+  EXPECT_THAT(helloCase.segments()[0].slot, Eq(0u));
+  EXPECT_THAT(helloCase.segments()[2].slot, Eq(1u));
+  EXPECT_THAT(helloCase.segments()[4].slot, Eq(0u));
+
+  const auto& fishConfig = configs.get(test_msgs::kCoupleFishCount);
+  EXPECT_THAT(fishConfig.numSlots(), Eq(3u));
+  const auto* fishCase = fishConfig.pluralCase(test_msgs::kCoupleFishCount, 2);
+  EXPECT_THAT(fishCase->segments()[0].slot, Eq(1u));
+  EXPECT_THAT(fishCase->segments()[2].slot, Eq(0u));
+  EXPECT_THAT(fishCase->segments()[4].slot, Eq(2u));
+}
+
+TEST(SimpleTranslatorSlotsTest, ShouldTranslateRepeatedAndManyArgs) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  std::string manyArgsMsg;
+  for (int i = 0; i < 20; ++i) {
+    manyArgsMsg += "%{k" + std::to_string(i) + "}";
+  }
+  manyArgsMsg += "|%{k19}%{k0}";
+  configs->add(test_msgs::kHelloName, "%{name}, %{name}, %{name}!")
+      .add(test_msgs::kNoArgs, manyArgsMsg);
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+
+  EXPECT_THAT(translator.translate(test_msgs::kHelloName, {{"name", "hey"}}), Eq("hey, hey, hey!"));
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  for (int i = 0; i < 20; ++i) {
+    keys.push_back("k" + std::to_string(i));
+    values.push_back(std::string(1, static_cast<char>('a' + i)));
+  }
+  simple_tr8n::TransArgs<char> args;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    args.add(keys[i], values[i]);
+  }
+  EXPECT_THAT(translator.translate(test_msgs::kNoArgs, args), Eq("abcdefghijklmnopqrst|ta"));
+}
+
 namespace test_wmsgs {
 
 constexpr wchar_t kNoArgs[] = L"test.no_args";
@@ -406,6 +856,15 @@ TEST_F(SimpleTranslatorWCharTest, ShouldWorkWithWideChars) {
               {L"fishCount", L"6"},
           }),
       Eq(L"Alice and Bob, you have 6 fish"));
+  EXPECT_THAT(
+      enTranslator->translatePlural(
+          test_wmsgs::kCoupleFishCount, L"fishCount",
+          {
+              {L"person1Name", L"Alice"},
+              {L"person2Name", L"Bob"},
+              {L"fishCount", 16},
+          }),
+      Eq(L"Alice and Bob, you have 16 fish"));
 
 #ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
 
@@ -419,3 +878,155 @@ TEST_F(SimpleTranslatorWCharTest, ShouldWorkWithWideChars) {
 
 #endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
 }
+
+namespace test_descs {
+
+constexpr auto kNoArgs = simple_tr8n::makeMsgDescriptor("test.no_args");
+constexpr auto kHelloName = simple_tr8n::makeMsgDescriptor("test.hello_name", "personName");
+constexpr auto kCoupleFishCount = simple_tr8n::makeMsgDescriptor(
+    "test.couple_fish_count", "person1Name", "person2Name", "fishCount");
+
+}  // namespace test_descs
+
+class SimpleTranslatorDescriptorTest : public Test {
+protected:
+  void SetUp() override {
+    auto enConfig = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+    enConfig->add(test_descs::kNoArgs, "A simple message with no arguments")
+        .add(test_descs::kHelloName, "hello, %{personName}!")
+        .add(
+            test_descs::kCoupleFishCount,
+            {
+                {0, "%{person1Name} and %{person2Name}, you have no fish"},
+                {1, "%{person1Name} and %{person2Name}, you have a fish"},
+                {2, "%{person2Name} and %{person1Name}, you have %{fishCount} fish"},
+            });
+    enTranslator = std::make_unique<simple_tr8n::SimpleTranslator<char>>(std::move(enConfig));
+
+    // Same messages, but added by plain message type strings.
+    auto esConfig = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+    esConfig->add(test_msgs::kNoArgs, "Un mensaje simple sin argumentos")
+        .add(test_msgs::kHelloName, "hola, %{personName}!")
+        .add(
+            test_msgs::kCoupleFishCount,
+            {
+                {1, "%{person1Name} y %{person2Name}, tienen un pez"},
+                {2, "%{person1Name} y %{person2Name}, tienen %{fishCount} peces"},
+            });
+    esTranslator = std::make_unique<simple_tr8n::SimpleTranslator<char>>(std::move(esConfig));
+  }
+
+  std::unique_ptr<simple_tr8n::SimpleTranslator<char>> enTranslator;
+  std::unique_ptr<simple_tr8n::SimpleTranslator<char>> esTranslator;
+};
+
+TEST_F(SimpleTranslatorDescriptorTest, ShouldTranslateBoundDescriptors) {
+  EXPECT_THAT(
+      enTranslator->translate(test_descs::kNoArgs), Eq("A simple message with no arguments"));
+  EXPECT_THAT(enTranslator->translate(test_descs::kHelloName, "Bob"), Eq("hello, Bob!"));
+
+  const std::string fishCount = "7";
+  EXPECT_THAT(
+      enTranslator->translatePlural(test_descs::kCoupleFishCount, 1, "Alice", "Bob", fishCount),
+      Eq("Alice and Bob, you have a fish"));
+  EXPECT_THAT(
+      enTranslator->translatePlural(test_descs::kCoupleFishCount, 7, "Alice", "Bob", fishCount),
+      Eq("Bob and Alice, you have 7 fish"));
+
+  const long long numFish = 12;
+  EXPECT_THAT(
+      enTranslator->translatePlural(test_descs::kCoupleFishCount, 12, "Alice", "Bob", numFish),
+      Eq("Bob and Alice, you have 12 fish"));
+  EXPECT_THAT(
+      enTranslator->translatePlural(test_descs::kCoupleFishCount, 2, "Alice", "Bob", 2.5),
+      Eq("Bob and Alice, you have 2.5 fish"));
+}
+
+TEST_F(SimpleTranslatorDescriptorTest, ShouldMatchReorderedDescriptorsByKey) {
+  // Same message type and arity as the bound descriptor, but different key order.
+  constexpr auto kReordered = simple_tr8n::makeMsgDescriptor(
+      "test.couple_fish_count", "fishCount", "person2Name", "person1Name");
+  constexpr auto kOriginal = simple_tr8n::makeMsgDescriptor(
+      "test.couple_fish_count", "fishCount", "person1Name", "person2Name");
+  static_assert(kReordered.argKeysHash() != kOriginal.argKeysHash(), "Hash must depend on order");
+  EXPECT_THAT(
+      enTranslator->translatePlural(kReordered, 1, "1", "Bob", "Alice"),
+      Eq("Alice and Bob, you have a fish"));
+  EXPECT_THAT(
+      enTranslator->translatePlural(kReordered, 5, "5", "Bob", "Alice"),
+      Eq("Bob and Alice, you have 5 fish"));
+}
+
+TEST_F(SimpleTranslatorDescriptorTest, ShouldTranslateUnboundDescriptors) {
+  EXPECT_THAT(esTranslator->translate(test_descs::kNoArgs), Eq("Un mensaje simple sin argumentos"));
+  EXPECT_THAT(esTranslator->translate(test_descs::kHelloName, "Bob"), Eq("hola, Bob!"));
+  EXPECT_THAT(
+      esTranslator->translatePlural(test_descs::kCoupleFishCount, 3, "Alice", "Bob", "3"),
+      Eq("Alice y Bob, tienen 3 peces"));
+}
+
+TEST_F(SimpleTranslatorDescriptorTest, ShouldTranslateThroughInterface) {
+  const simple_tr8n::Translator<char>& translator = *enTranslator;
+  EXPECT_THAT(translator.translate(test_descs::kHelloName, "Bob"), Eq("hello, Bob!"));
+  EXPECT_THAT(
+      translator.translatePlural(test_descs::kCoupleFishCount, 0, "Alice", "Bob", "0"),
+      Eq("Alice and Bob, you have no fish"));
+  EXPECT_THAT(
+      translator.translatePlural(test_descs::kCoupleFishCount, 3, "Alice", "Bob", 3),
+      Eq("Bob and Alice, you have 3 fish"));
+
+  // Plain message type strings are still supported for bound messages.
+  EXPECT_THAT(
+      translator.translate(test_msgs::kHelloName, {{"personName", "Bob"}}), Eq("hello, Bob!"));
+}
+
+#ifdef SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST_F(SimpleTranslatorDescriptorTest, ShouldHandleErrors) {
+  // Message uses an argument key not declared by its descriptor:
+  simple_tr8n::MsgConfigs<char> configs;
+  try {
+    configs.add(test_descs::kHelloName, "hello, %{name}!");
+    FAIL() << "Expecting MissingArgException";
+  } catch (const simple_tr8n::MissingArgException<char>& e) {
+    EXPECT_THAT(
+        e.what(),
+        StrEq("simple_tr8n::MissingArgException: (msgType) test.hello_name: (argKey) name"));
+  }
+
+  // Plural mismatch:
+  try {
+    enTranslator->translatePlural(test_descs::kHelloName, 2, "Bob");
+    FAIL() << "Expecting InvalidArgsException";
+  } catch (const simple_tr8n::InvalidArgsException<char>& e) {
+    EXPECT_THAT(e.what(), StrEq("simple_tr8n::InvalidArgsException: test.hello_name"));
+  }
+
+  // No matching plural case (<= count):
+  try {
+    esTranslator->translatePlural(test_descs::kCoupleFishCount, 0, "Alice", "Bob", "0");
+    FAIL() << "Expecting InvalidArgsException";
+  } catch (const simple_tr8n::InvalidArgsException<char>& e) {
+    EXPECT_THAT(e.what(), StrEq("simple_tr8n::InvalidArgsException: test.couple_fish_count"));
+  }
+}
+
+#else  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
+
+TEST_F(SimpleTranslatorDescriptorTest, ShouldHandleErrors) {
+  // Message uses an argument key not declared by its descriptor (substituted
+  // as an empty string):
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_descs::kHelloName, "hello, %{name}!");
+  simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+  EXPECT_THAT(translator.translate(test_descs::kHelloName, "Bob"), Eq("hello, !"));
+
+  // Plural mismatch:
+  EXPECT_THAT(enTranslator->translatePlural(test_descs::kHelloName, 2, "Bob"), Eq(""));
+
+  // No matching plural case (<= count):
+  EXPECT_THAT(
+      esTranslator->translatePlural(test_descs::kCoupleFishCount, 0, "Alice", "Bob", "0"), Eq(""));
+}
+
+#endif  // SIMPLE_TR8N_ENABLE_EXCEPTIONS
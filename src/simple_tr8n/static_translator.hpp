@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_STATIC_TRANSLATOR_HPP
+#define SIMPLE_TR8N_STATIC_TRANSLATOR_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "simple_tr8n/string_view.hpp"
+#include "simple_tr8n/translator.hpp"
+
+namespace simple_tr8n {
+
+/**
+ * Non-virtual translation facade, bound at compile time to the concrete
+ * translator type Impl (e.g. StaticTranslator<SimpleTranslator<char>>). Meant
+ * for hot loops and for code templated on the translator type: when Impl is
+ * final (like SimpleTranslator), every call is dispatched statically, so the
+ * compiler can inline message lookup and rendering into the call site.
+ *
+ * Translator<CharT> stays the type-erased option. A StaticTranslator of a
+ * non-final type (including Translator<CharT> itself) still works, but
+ * dispatches virtually, like calling the translator directly.
+ *
+ * Only views the translator, which must outlive it, so is cheap to copy.
+ */
+template<typename Impl>
+class StaticTranslator {
+public:
+  using string_type = typename Impl::string_type;
+  using char_type = typename string_type::value_type;
+
+  static_assert(
+      std::is_base_of<Translator<char_type>, Impl>::value,
+      "StaticTranslator requires a Translator implementation");
+
+  explicit StaticTranslator(const Impl& impl) : impl_{&impl} {}
+
+  ~StaticTranslator() = default;
+
+  StaticTranslator(const StaticTranslator&) = default;
+  StaticTranslator& operator=(const StaticTranslator&) = default;
+
+  StaticTranslator(StaticTranslator&&) = default;
+  StaticTranslator& operator=(StaticTranslator&&) = default;
+
+  /** Returns true if calls are dispatched statically (i.e. Impl is final). */
+  static constexpr bool isStatic() { return std::is_final<Impl>::value; }
+
+  /** The viewed translator. */
+  const Impl& impl() const { return *impl_; }
+
+  /** See Translator::translate(msgType). */
+  string_type translate(basic_string_view<char_type> msgType) const {
+    return impl_->translate(msgType);
+  }
+
+  /** See Translator::translate(msgType, args). */
+  string_type translate(
+      basic_string_view<char_type> msgType, const TransArgs<char_type>& args) const {
+    return impl_->translate(msgType, args);
+  }
+
+  /** See Translator::translatePlural(msgType, pluralCount, args). */
+  string_type translatePlural(
+      basic_string_view<char_type> msgType, int pluralCount,
+      const TransArgs<char_type>& args) const {
+    return impl_->translatePlural(msgType, pluralCount, args);
+  }
+
+  /** See Translator::resolve(). */
+  MsgId<char_type> resolve(basic_string_view<char_type> msgType) const {
+    return impl_->resolve(msgType);
+  }
+
+  /** See Translator::translate(msgId). */
+  string_type translate(const MsgId<char_type>& msgId) const { return impl_->translate(msgId); }
+
+  /** See Translator::translate(msgId, args). */
+  string_type translate(const MsgId<char_type>& msgId, const TransArgs<char_type>& args) const {
+    return impl_->translate(msgId, args);
+  }
+
+  /** See Translator::translatePlural(msgId, pluralCount, args). */
+  string_type translatePlural(
+      const MsgId<char_type>& msgId, int pluralCount, const TransArgs<char_type>& args) const {
+    return impl_->translatePlural(msgId, pluralCount, args);
+  }
+
+  /** See Translator::translateTo(out, msgType). */
+  void translateTo(string_type& out, basic_string_view<char_type> msgType) const {
+    impl_->translateTo(out, msgType);
+  }
+
+  /** See Translator::translateTo(out, msgType, args). */
+  void translateTo(
+      string_type& out, basic_string_view<char_type> msgType,
+      const TransArgs<char_type>& args) const {
+    impl_->translateTo(out, msgType, args);
+  }
+
+  /** See Translator::translatePluralTo(). */
+  void translatePluralTo(
+      string_type& out, basic_string_view<char_type> msgType, int pluralCount,
+      const TransArgs<char_type>& args) const {
+    impl_->translatePluralTo(out, msgType, pluralCount, args);
+  }
+
+  /** See Translator::translateBatch(). */
+  void translateBatch(
+      gsl::span<const TransRequest<char_type>> requests, string_type& out,
+      std::vector<std::size_t>& offsets) const {
+    impl_->translateBatch(requests, out, offsets);
+  }
+
+  /** See Translator::translate(msg, values...). */
+  template<std::size_t NumArgs, typename... Values>
+  string_type translate(
+      const MsgDescriptor<char_type, NumArgs>& msg, const Values&... values) const {
+    return impl_->translate(msg, values...);
+  }
+
+  /** See Translator::translatePlural(msg, pluralCount, values...). */
+  template<std::size_t NumArgs, typename... Values>
+  string_type translatePlural(
+      const MsgDescriptor<char_type, NumArgs>& msg, int pluralCount,
+      const Values&... values) const {
+    return impl_->translatePlural(msg, pluralCount, values...);
+  }
+
+private:
+  const Impl* impl_;
+};
+
+/** Returns a StaticTranslator viewing the given translator. */
+template<typename Impl>
+StaticTranslator<Impl> makeStaticTranslator(const Impl& impl) {
+  return StaticTranslator<Impl>{impl};
+}
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_STATIC_TRANSLATOR_HPP
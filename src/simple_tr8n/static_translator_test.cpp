@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "simple_tr8n/simple_translator.hpp"
+#include "simple_tr8n/static_translator.hpp"
+#include "simple_tr8n/translator.hpp"
+
+namespace test_msgs {
+
+constexpr char kNoArgs[] = "test.no_args";
+constexpr char kHelloName[] = "test.hello_name";
+constexpr char kNumFiles[] = "test.num_files";
+
+constexpr auto kSum = simple_tr8n::makeMsgDescriptor("test.sum", "a", "b");
+constexpr auto kNumItems = simple_tr8n::makeMsgDescriptor("test.num_items", "num");
+
+}  // namespace test_msgs
+
+namespace {
+
+std::unique_ptr<simple_tr8n::SimpleTranslator<char>> makeTranslator() {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kNoArgs, "Saved")
+      .add(test_msgs::kHelloName, "hello, %{personName}!")
+      .add(test_msgs::kNumFiles, {{0, "no files"}, {1, "1 file"}, {2, "%{num} files"}})
+      .add(test_msgs::kSum, "%{a} + %{b}")
+      .add(test_msgs::kNumItems, {{1, "1 item"}, {2, "%{num} items"}});
+  return std::make_unique<simple_tr8n::SimpleTranslator<char>>(std::move(configs));
+}
+
+/** Exercises every StaticTranslator entry point (as generic code would). */
+template<typename Impl>
+std::vector<std::string> translateAll(simple_tr8n::StaticTranslator<Impl> translator) {
+  std::vector<std::string> results;
+  results.push_back(translator.translate(test_msgs::kNoArgs));
+  results.push_back(translator.translate(test_msgs::kHelloName, {{"personName", "Amy"}}));
+  results.push_back(translator.translatePlural(test_msgs::kNumFiles, 3, {{"num", "3"}}));
+
+  const auto msgId = translator.resolve(test_msgs::kHelloName);
+  results.push_back(translator.translate(msgId, {{"personName", "Bo"}}));
+
+  std::string out = "> ";
+  translator.translateTo(out, test_msgs::kNoArgs);
+  translator.translatePluralTo(out, test_msgs::kNumFiles, 0, {});
+  results.push_back(out);
+
+  results.push_back(translator.translate(test_msgs::kSum, "1", "2"));
+  results.push_back(translator.translatePlural(test_msgs::kNumItems, 5, "5"));
+
+  const std::vector<simple_tr8n::TransRequest<char>> requests = {
+      {test_msgs::kNoArgs}, {test_msgs::kNumFiles, nullptr, 1}};
+  std::vector<std::size_t> offsets;
+  translator.translateBatch(requests, out, offsets);
+  results.push_back(out);
+  return results;
+}
+
+}  // namespace
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+
+static_assert(
+    simple_tr8n::StaticTranslator<simple_tr8n::SimpleTranslator<char>>::isStatic(),
+    "SimpleTranslator should be dispatched statically");
+static_assert(
+    !simple_tr8n::StaticTranslator<simple_tr8n::Translator<char>>::isStatic(),
+    "Translator should be dispatched virtually");
+
+TEST(StaticTranslatorTest, ShouldTranslateThroughConcreteType) {
+  const auto translator = makeTranslator();
+  const auto facade = simple_tr8n::makeStaticTranslator(*translator);
+  EXPECT_THAT(&facade.impl(), Eq(translator.get()));
+
+  EXPECT_THAT(
+      translateAll(facade),
+      ElementsAre(
+          "Saved", "hello, Amy!", "3 files", "hello, Bo!", "> Savedno files", "1 + 2", "5 items",
+          "Saved1 file"));
+}
+
+TEST(StaticTranslatorTest, ShouldTranslateThroughInterface) {
+  const auto translator = makeTranslator();
+  const simple_tr8n::Translator<char>& api = *translator;
+
+  EXPECT_THAT(
+      translateAll(simple_tr8n::makeStaticTranslator(api)),
+      ElementsAre(
+          "Saved", "hello, Amy!", "3 files", "hello, Bo!", "> Savedno files", "1 + 2", "5 items",
+          "Saved1 file"));
+}
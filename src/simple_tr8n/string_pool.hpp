@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMPLE_TR8N_STRING_POOL_HPP
+#define SIMPLE_TR8N_STRING_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "simple_tr8n/perfect_hash.hpp"
+#include "simple_tr8n/string_view.hpp"
+
+namespace simple_tr8n {
+
+/**
+ * Append-only pool of interned strings, which several MsgConfigs (e.g. for
+ * different locales) can freeze into so that identical message types and
+ * message texts are stored only once across all of them.
+ *
+ * Interned strings are never modified or moved, so views of them stay valid
+ * for the lifetime of the pool. (MsgConfigs frozen into a pool share
+ * ownership of it.) All member functions are thread-safe.
+ */
+template<typename CharT>
+class StringPool {
+public:
+  /** Interning statistics. */
+  struct Stats {
+    std::size_t numStrings = 0;      // Distinct strings stored.
+    std::size_t numInterned = 0;     // Total intern() calls.
+    std::size_t storedChars = 0;     // Characters stored for distinct strings.
+    std::size_t internedChars = 0;   // Characters passed to all intern() calls.
+
+    /** Bytes that storing every interned string separately would have used. */
+    std::size_t savedBytes() const { return (internedChars - storedChars) * sizeof(CharT); }
+  };
+
+  StringPool() = default;
+  ~StringPool() = default;
+
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  StringPool(StringPool&&) = delete;
+  StringPool& operator=(StringPool&&) = delete;
+
+  /**
+   * Returns a view of the pooled copy of str, copying it into the pool only if
+   * no equal string has been interned yet.
+   */
+  basic_string_view<CharT> intern(basic_string_view<CharT> str) {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    ++stats_.numInterned;
+    stats_.internedChars += str.size();
+
+    const auto itr = strings_.find(str);
+    if (itr != strings_.end()) {
+      return *itr;
+    }
+
+    const basic_string_view<CharT> pooled = store(str);
+    strings_.insert(pooled);
+    ++stats_.numStrings;
+    stats_.storedChars += str.size();
+    return pooled;
+  }
+
+  /** Returns interning statistics so far (e.g. to report bytes saved). */
+  Stats stats() const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return stats_;
+  }
+
+private:
+  /** Characters per storage block (longer strings get their own block). */
+  static constexpr std::size_t kBlockSize = 16 * 1024;
+
+  struct Hash {
+    std::size_t operator()(basic_string_view<CharT> str) const {
+      return static_cast<std::size_t>(internal::hashKey<CharT>(str, 0));
+    }
+  };
+
+  basic_string_view<CharT> store(basic_string_view<CharT> str) {
+    if (str.empty()) {
+      return basic_string_view<CharT>{};
+    }
+
+    if (str.size() > kBlockSize / 2) {
+      // Give long strings their own block, keeping the current block current.
+      std::unique_ptr<CharT[]> block{new CharT[str.size()]};
+      std::copy(str.begin(), str.end(), block.get());
+      const basic_string_view<CharT> stored{block.get(), str.size()};
+      blocks_.insert(blocks_.empty() ? blocks_.end() : blocks_.end() - 1, std::move(block));
+      return stored;
+    }
+
+    if (str.size() > kBlockSize - blockUsed_) {
+      blocks_.emplace_back(new CharT[kBlockSize]);
+      blockUsed_ = 0;
+    }
+
+    CharT* const dest = blocks_.back().get() + blockUsed_;
+    std::copy(str.begin(), str.end(), dest);
+    blockUsed_ += str.size();
+    return basic_string_view<CharT>{dest, str.size()};
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_set<basic_string_view<CharT>, Hash> strings_;
+  std::vector<std::unique_ptr<CharT[]>> blocks_;
+  std::size_t blockUsed_ = kBlockSize;  // Characters used in the current (last) block.
+  Stats stats_;
+};
+
+template<typename CharT>
+constexpr std::size_t StringPool<CharT>::kBlockSize;
+
+}  // namespace simple_tr8n
+
+#endif  // SIMPLE_TR8N_STRING_POOL_HPP
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "simple_tr8n/simple_translator.hpp"
+#include "simple_tr8n/string_pool.hpp"
+
+namespace test_msgs {
+
+constexpr char kBrand[] = "test.brand";
+constexpr char kHelloName[] = "test.hello_name";
+
+}  // namespace test_msgs
+
+using ::testing::Eq;
+using ::testing::Ne;
+
+TEST(StringPoolTest, ShouldInternEqualStringsOnce) {
+  simple_tr8n::StringPool<char> pool;
+  const std::string hello = "hello";
+  const auto first = pool.intern(hello);
+  const auto second = pool.intern(std::string{"hello"});
+  const auto other = pool.intern("world");
+
+  EXPECT_THAT(first, Eq("hello"));
+  EXPECT_THAT(first.data(), Eq(second.data()));
+  EXPECT_THAT(first.data(), Ne(hello.data()));
+  EXPECT_THAT(other, Eq("world"));
+
+  const auto stats = pool.stats();
+  EXPECT_THAT(stats.numStrings, Eq(2u));
+  EXPECT_THAT(stats.numInterned, Eq(3u));
+  EXPECT_THAT(stats.storedChars, Eq(10u));
+  EXPECT_THAT(stats.internedChars, Eq(15u));
+  EXPECT_THAT(stats.savedBytes(), Eq(5u));
+}
+
+TEST(StringPoolTest, ShouldKeepViewsValidAsPoolGrows) {
+  simple_tr8n::StringPool<wchar_t> pool;
+  const auto first = pool.intern(L"first");
+  const std::wstring longStr(100000, L'x');
+  const auto longView = pool.intern(longStr);
+  for (int i = 0; i < 10000; ++i) {
+    pool.intern(L"string number " + std::to_wstring(i));
+  }
+
+  EXPECT_THAT(first, Eq(L"first"));
+  EXPECT_THAT(longView, Eq(longStr));
+  EXPECT_THAT(pool.intern(L"string number 123"), Eq(L"string number 123"));
+  EXPECT_THAT(pool.stats().numStrings, Eq(10002u));
+}
+
+TEST(StringPoolTest, ShouldShareStringsAcrossMsgConfigs) {
+  auto pool = std::make_shared<simple_tr8n::StringPool<char>>();
+
+  auto enConfigs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  enConfigs->add(test_msgs::kBrand, "SimpleTr8n").add(test_msgs::kHelloName, "hello, %{name}!");
+  enConfigs->freeze(pool);
+
+  auto esConfigs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  esConfigs->add(test_msgs::kBrand, "SimpleTr8n").add(test_msgs::kHelloName, "hola, %{name}!");
+  esConfigs->freeze(pool);
+
+  EXPECT_THAT(
+      enConfigs->get(test_msgs::kBrand).onlyCase().msg().data(),
+      Eq(esConfigs->get(test_msgs::kBrand).onlyCase().msg().data()));
+
+  // Both message types and one message text stored once.
+  EXPECT_THAT(pool.use_count(), Eq(3));
+  EXPECT_THAT(
+      pool->stats().savedBytes(),
+      Eq(sizeof(test_msgs::kBrand) - 1 + sizeof(test_msgs::kHelloName) - 1 + 10));
+
+  // Pool outlives its creator's reference.
+  pool.reset();
+  const simple_tr8n::SimpleTranslator<char> es{std::move(esConfigs)};
+  EXPECT_THAT(es.translate(test_msgs::kHelloName, {{"name", "Ana"}}), Eq("hola, Ana!"));
+}
@@ -6,54 +6,631 @@
 #define SIMPLE_TR8N_TRANSLATOR_HPP
 
 #include <algorithm>
+#include <array>
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <initializer_list>
+#include <limits>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#ifdef __has_include
+  #if __has_include(<charconv>) && __cplusplus >= 201703L
+    #include <charconv>
+  #endif
+#endif
+
 #include <gsl/gsl>
 
 #include "simple_tr8n/string_view.hpp"
 
 namespace simple_tr8n {
+namespace internal {
+
+/** Count value used to represent a non-plural case. */
+constexpr int kNoCount = -1;
+
+/**
+ * 64-bit FNV-1a hash of an ordered list of numArgKeys argument keys (e.g. a
+ * MsgDescriptor's), which differs if the keys or their order differ. Usable
+ * in constant expressions, so descriptors compute it at compile time.
+ */
+template<typename CharT, typename ArgKeys>
+constexpr std::uint64_t hashArgKeys(const ArgKeys& argKeys, std::size_t numArgKeys) {
+  constexpr std::uint64_t kFnvPrime = 0x100000001b3ULL;
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (std::size_t i = 0; i < numArgKeys; ++i) {
+    const basic_string_view<CharT> argKey = argKeys[i];
+    for (std::size_t j = 0; j < argKey.size(); ++j) {
+      hash = (hash ^ static_cast<std::uint64_t>(argKey[j])) * kFnvPrime;
+    }
+    // Note: Mix in each length, so that e.g. {"ab", "c"} and {"a", "bc"} differ.
+    hash = (hash ^ argKey.size()) * kFnvPrime;
+  }
+  return hash;
+}
+
+}  // namespace internal
+
+/**
+ * Declares a message type together with the keys of its arguments, in the
+ * order their values will be passed to Translator::translate() or
+ * translatePlural(). Passing the wrong number of argument values for a
+ * descriptor is a compile error.
+ *
+ * Usually declared as a constexpr constant via makeMsgDescriptor().
+ */
+template<typename CharT, std::size_t NumArgs>
+class MsgDescriptor {
+public:
+  using arg_keys_type = std::array<basic_string_view<CharT>, NumArgs>;
+
+  constexpr MsgDescriptor(basic_string_view<CharT> msgType, arg_keys_type argKeys)
+      : msgType_{msgType},
+        argKeys_{argKeys},
+        argKeysHash_{internal::hashArgKeys<CharT>(argKeys, NumArgs)} {}
+
+  /** Message type string identifier. */
+  constexpr basic_string_view<CharT> msgType() const { return msgType_; }
+
+  /** Argument keys, in positional order. */
+  constexpr const arg_keys_type& argKeys() const { return argKeys_; }
+
+  /** Hash of argKeys() (see internal::hashArgKeys()), computed once. */
+  constexpr std::uint64_t argKeysHash() const { return argKeysHash_; }
+
+private:
+  basic_string_view<CharT> msgType_;
+  arg_keys_type argKeys_;
+  std::uint64_t argKeysHash_;
+};
+
+/**
+ * Returns a MsgDescriptor for the given message type and argument keys, e.g.:
+ *
+ *   constexpr auto kExampleMsgA =
+ *       simple_tr8n::makeMsgDescriptor("your_project.a", "userFirstName", "userAge");
+ */
+template<typename CharT, std::size_t N, typename... ArgKeys>
+constexpr MsgDescriptor<CharT, sizeof...(ArgKeys)> makeMsgDescriptor(
+    const CharT (&msgType)[N], const ArgKeys&... argKeys) {
+  return MsgDescriptor<CharT, sizeof...(ArgKeys)>{
+      basic_string_view<CharT>{msgType, N - 1}, {{basic_string_view<CharT>{argKeys}...}}};
+}
+
+/**
+ * Handle for a message type, as returned by Translator::resolve(), that can be
+ * passed to translate() and translatePlural() in place of the message type
+ * string to skip looking it up by string each time.
+ *
+ * Implementations decide what (if anything) to pre-resolve. For
+ * SimpleTranslator, a handle indexes directly into its frozen MsgConfigs, and
+ * stays valid for every SimpleTranslator whose MsgConfigs has the same set of
+ * message types (e.g. every locale of the same catalog). Using a handle with
+ * any other Translator still works, but falls back to lookup by msgType().
+ *
+ * The message type string must outlive the handle.
+ */
+template<typename CharT>
+class MsgId {
+public:
+  /** index() value for a handle that has not been resolved to an index. */
+  static constexpr std::uint32_t kUnresolved = std::numeric_limits<std::uint32_t>::max();
+
+  /** Unresolved handle for the given message type. */
+  explicit MsgId(basic_string_view<CharT> msgType) : msgType_{msgType} {}
+
+  /** Handle resolved to index within the set of message types keySetId. */
+  MsgId(basic_string_view<CharT> msgType, std::uint32_t index, std::uint64_t keySetId)
+      : msgType_{msgType}, index_{index}, keySetId_{keySetId} {}
+
+  basic_string_view<CharT> msgType() const { return msgType_; }
+  std::uint32_t index() const { return index_; }
+  std::uint64_t keySetId() const { return keySetId_; }
+
+private:
+  basic_string_view<CharT> msgType_;
+  std::uint32_t index_ = kUnresolved;
+  std::uint64_t keySetId_ = 0;
+};
+
+template<typename CharT>
+constexpr std::uint32_t MsgId<CharT>::kUnresolved;
+
+namespace internal {
+
+/** Max length of a formatted number argument, e.g. "-2.2250738585072014e-308". */
+constexpr std::size_t kMaxNumberChars = 24;
+
+/**
+ * Whether T is an integer or floating-point type that can be passed as a
+ * number argument value (excluding bool and character types).
+ */
+template<typename T, typename CharT>
+struct IsNumberArg
+    : std::integral_constant<
+          bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                    !std::is_same<T, char>::value && !std::is_same<T, CharT>::value> {};
+
+/** Writes magnitude in decimal to out, returning the number of characters written. */
+template<typename CharT>
+std::size_t formatInteger(std::uint64_t magnitude, bool negative, CharT* out) {
+  std::size_t length = negative ? 2 : 1;
+  for (std::uint64_t rest = magnitude / 10; rest != 0; rest /= 10) {
+    ++length;
+  }
+
+  CharT* pos = out + length;
+  do {
+    *--pos = static_cast<CharT>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+
+  if (negative) {
+    *out = static_cast<CharT>('-');
+  }
+  return length;
+}
+
+/**
+ * Writes the shortest decimal representation of value that round-trips to
+ * out, returning the number of characters written.
+ */
+template<typename CharT>
+std::size_t formatFloating(double value, CharT* out) {
+  std::array<char, kMaxNumberChars + 8> chars;
+#ifdef __cpp_lib_to_chars
+  const auto length =
+      static_cast<std::size_t>(std::to_chars(chars.data(), chars.data() + chars.size(), value).ptr -
+                               chars.data());
+#else
+  // Note: Without floating-point std::to_chars(), try increasing precision
+  // until the value round-trips, and undo any locale-specific decimal point.
+  int printed = 0;
+  for (int precision = 15; precision <= 17; ++precision) {
+    printed = std::snprintf(chars.data(), chars.size(), "%.*g", precision, value);
+    if (std::strtod(chars.data(), nullptr) == value) {
+      break;
+    }
+  }
+  const auto length = static_cast<std::size_t>(printed);
+  std::replace(chars.data(), chars.data() + length, *std::localeconv()->decimal_point, '.');
+#endif
+
+  std::copy(chars.data(), chars.data() + length, out);
+  return length;
+}
+
+/** Integer or floating-point argument value, to be formatted in place. */
+class NumberArg {
+public:
+  NumberArg() = default;
+
+  template<
+      typename T,
+      typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type =
+          0>
+  explicit NumberArg(T value) : kind_{Kind::kSigned}, signed_{value} {}
+
+  template<
+      typename T,
+      typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::
+          type = 0>
+  explicit NumberArg(T value) : kind_{Kind::kUnsigned}, unsigned_{value} {}
+
+  // Note: long double values are formatted with double precision.
+  template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+  explicit NumberArg(T value) : kind_{Kind::kFloating}, floating_{static_cast<double>(value)} {}
+
+  /**
+   * Writes the value in decimal to out, which must have room for
+   * kMaxNumberChars, returning the number of characters written.
+   */
+  template<typename CharT>
+  std::size_t format(CharT* out) const {
+    switch (kind_) {
+      case Kind::kSigned: {
+        const auto magnitude = static_cast<std::uint64_t>(signed_);
+        return formatInteger(signed_ < 0 ? 0 - magnitude : magnitude, signed_ < 0, out);
+      }
+      case Kind::kUnsigned:
+        return formatInteger(unsigned_, false, out);
+      case Kind::kFloating:
+        return formatFloating(floating_, out);
+    }
+    return 0;
+  }
+
+private:
+  enum class Kind : std::uint8_t { kSigned, kUnsigned, kFloating };
+
+  Kind kind_ = Kind::kSigned;
+  union {
+    std::int64_t signed_ = 0;
+    std::uint64_t unsigned_;
+    double floating_;
+  };
+};
+
+}  // namespace internal
+
+/**
+ * One key and value in a TransArgs initializer list, where the value is
+ * either a string or a number (see TransArgs::add()), e.g.
+ * {{"userName", name}, {"numFiles", 3}}.
+ */
+template<typename CharT>
+struct TransArg {
+  TransArg(basic_string_view<CharT> key, basic_string_view<CharT> value)
+      : key{key}, value{value} {}
+
+  template<
+      typename T, typename std::enable_if<internal::IsNumberArg<T, CharT>::value, int>::type = 0>
+  TransArg(basic_string_view<CharT> key, T number) : key{key}, number{number}, isNumber{true} {}
+
+  basic_string_view<CharT> key;
+  basic_string_view<CharT> value;
+  internal::NumberArg number;
+  bool isNumber = false;
+};
 
 /**
  * Represents a set of named arguments to be substituted into a user-visible
  * string. All added string values must have lifetimes longer than this
  * TransArgs object.
+ *
+ * Values can also be integers or floating-point numbers, which are formatted
+ * in place (in the shortest decimal form that round-trips, independent of
+ * locale) when added, without any temporary strings. get(), find() and at()
+ * then view the formatted number.
+ *
+ * The first kInlineArgs arguments are stored inline, so typical argument lists
+ * don't need any heap allocation.
  */
 template<typename CharT>
 class TransArgs {
 public:
   using keyval_type = std::pair<basic_string_view<CharT>, basic_string_view<CharT>>;
 
-  TransArgs() = default;
-  TransArgs(std::initializer_list<keyval_type> args) : args_{std::move(args)} {}
+  /** Number of arguments stored inline before spilling to the heap. */
+  static constexpr std::size_t kInlineArgs = 4;
 
-  /** Returns true if an argument with the given key has been provided. */
-  bool has(basic_string_view<CharT> key) const {
-    const auto itr = std::find_if(
-        args_.begin(), args_.end(), [&](const keyval_type& keyval) { return keyval.first == key; });
-    return itr != args_.end();
+  // Note: User-provided (unlike = default), so that a const TransArgs can be
+  // default-initialized without zeroing inlineNumbers_.
+  TransArgs() {}
+  TransArgs(std::initializer_list<TransArg<CharT>> args) {
+    for (const auto& arg : args) {
+      if (arg.isNumber) {
+        pushNumber(arg.key, arg.number);
+      } else {
+        push(arg.key, arg.value);
+      }
+    }
+  }
+
+  ~TransArgs() = default;
+
+  TransArgs(const TransArgs& other)
+      : inlineArgs_(other.inlineArgs_),
+        heapArgs_(other.heapArgs_),
+        heapNumbers_(other.heapNumbers_),
+        inlineNumberMask_(other.inlineNumberMask_),
+        size_(other.size_),
+        valuesLength_(other.valuesLength_) {
+    copyInlineNumbers(other);
   }
 
+  TransArgs& operator=(const TransArgs& other) {
+    if (this != &other) {
+      inlineArgs_ = other.inlineArgs_;
+      heapArgs_ = other.heapArgs_;
+      heapNumbers_ = other.heapNumbers_;
+      inlineNumberMask_ = other.inlineNumberMask_;
+      size_ = other.size_;
+      valuesLength_ = other.valuesLength_;
+      copyInlineNumbers(other);
+    }
+    return *this;
+  }
+
+  TransArgs(TransArgs&& other) noexcept
+      : inlineArgs_(other.inlineArgs_),
+        heapArgs_(std::move(other.heapArgs_)),
+        heapNumbers_(std::move(other.heapNumbers_)),
+        inlineNumberMask_(other.inlineNumberMask_),
+        size_(other.size_),
+        valuesLength_(other.valuesLength_) {
+    copyInlineNumbers(other);
+  }
+
+  TransArgs& operator=(TransArgs&& other) noexcept {
+    if (this != &other) {
+      inlineArgs_ = other.inlineArgs_;
+      heapArgs_ = std::move(other.heapArgs_);
+      heapNumbers_ = std::move(other.heapNumbers_);
+      inlineNumberMask_ = other.inlineNumberMask_;
+      size_ = other.size_;
+      valuesLength_ = other.valuesLength_;
+      copyInlineNumbers(other);
+    }
+    return *this;
+  }
+
+  /** Returns true if an argument with the given key has been provided. */
+  bool has(basic_string_view<CharT> key) const { return find(key) != nullptr; }
+
   /** Returns value of argument with given key, or emptry string if none was set. */
   basic_string_view<CharT> get(basic_string_view<CharT> key) const {
-    auto itr = std::find_if(
-        args_.begin(), args_.end(), [&](const keyval_type& keyval) { return keyval.first == key; });
-    return (itr != args_.end()) ? itr->second : basic_string_view<CharT>{};
+    const auto* value = find(key);
+    return (value != nullptr) ? *value : basic_string_view<CharT>{};
+  }
+
+  /** Returns pointer to value of argument with given key, or nullptr if none was set. */
+  const basic_string_view<CharT>* find(basic_string_view<CharT> key) const {
+    const std::size_t numInline = std::min(size_, kInlineArgs);
+    for (std::size_t i = 0; i < numInline; ++i) {
+      if (inlineArgs_[i].first == key) {
+        return &inlineArgs_[i].second;
+      }
+    }
+
+    for (const auto& keyval : heapArgs_) {
+      if (keyval.first == key) {
+        return &keyval.second;
+      }
+    }
+
+    return nullptr;
   }
 
   /** Adds an argument with the given key and value. */
   TransArgs& add(basic_string_view<CharT> key, basic_string_view<CharT> value) {
     Expects(!has(key));  // No replace support.
-    args_.emplace_back(key, value);
+    push(key, value);
     return *this;
   }
 
+  /**
+   * Adds an argument with the given key and integer or floating-point value,
+   * formatted in place (e.g. 1234 as "1234", and 0.5 as "0.5").
+   */
+  template<
+      typename T, typename std::enable_if<internal::IsNumberArg<T, CharT>::value, int>::type = 0>
+  TransArgs& add(basic_string_view<CharT> key, T number) {
+    Expects(!has(key));  // No replace support.
+    pushNumber(key, internal::NumberArg{number});
+    return *this;
+  }
+
+  /**
+   * Returns the value of the argument with the given key as a plural count, or
+   * internal::kNoCount if it's missing or not a non-negative decimal int (e.g.
+   * one added as an integer).
+   */
+  int pluralCount(basic_string_view<CharT> key) const {
+    const auto* value = find(key);
+    if (value == nullptr || value->empty()) {
+      return internal::kNoCount;
+    }
+
+    int count = 0;
+    for (const CharT c : *value) {
+      const int digit = static_cast<int>(c) - '0';
+      if (c < static_cast<CharT>('0') || c > static_cast<CharT>('9') ||
+          count > (std::numeric_limits<int>::max() - digit) / 10) {
+        return internal::kNoCount;
+      }
+      count = count * 10 + digit;
+    }
+    return count;
+  }
+
+  /** Number of arguments added. */
+  std::size_t size() const { return size_; }
+
+  /** Returns the argument at the given index, in the order added. */
+  const keyval_type& at(std::size_t i) const {
+    Expects(i < size_);
+    return (i < kInlineArgs) ? inlineArgs_[i] : heapArgs_[i - kInlineArgs];
+  }
+
+  /**
+   * Sum of the lengths of all argument values, e.g. for reserving space to
+   * render them into.
+   */
+  std::size_t valuesLength() const { return valuesLength_; }
+
 private:
-  // Most argument lists should be short, so just use a vector with linear search.
-  std::vector<keyval_type> args_;
+  void push(basic_string_view<CharT> key, basic_string_view<CharT> value) {
+    if (size_ < kInlineArgs) {
+      inlineArgs_[size_] = keyval_type{key, value};
+    } else {
+      heapArgs_.emplace_back(key, value);
+    }
+
+    ++size_;
+    valuesLength_ += value.size();
+  }
+
+  void pushNumber(basic_string_view<CharT> key, const internal::NumberArg& number) {
+    CharT* chars = nullptr;
+    if (size_ < kInlineArgs) {
+      chars = inlineNumbers_[size_].data();
+      inlineNumberMask_ = static_cast<std::uint8_t>(inlineNumberMask_ | (1u << size_));
+    } else {
+      heapNumbers_.push_back(std::make_shared<NumberChars>());
+      chars = heapNumbers_.back()->data();
+    }
+
+    push(key, basic_string_view<CharT>{chars, number.format(chars)});
+  }
+
+  /** Copies other's inline formatted numbers, repointing their values to the copies. */
+  void copyInlineNumbers(const TransArgs& other) {
+    for (std::size_t i = 0; i < kInlineArgs; ++i) {
+      if ((inlineNumberMask_ & (1u << i)) != 0) {
+        const std::size_t length = other.inlineArgs_[i].second.size();
+        std::copy_n(other.inlineNumbers_[i].data(), length, inlineNumbers_[i].data());
+        inlineArgs_[i].second = basic_string_view<CharT>{inlineNumbers_[i].data(), length};
+      }
+    }
+  }
+
+  using NumberChars = std::array<CharT, internal::kMaxNumberChars>;
+
+  // Most argument lists should be short, so just use linear search.
+  std::array<keyval_type, kInlineArgs> inlineArgs_;
+  std::vector<keyval_type> heapArgs_;  // Any arguments after the first kInlineArgs.
+
+  // Formatted number values: one slot per inline argument (in use if its bit
+  // in inlineNumberMask_ is set), and immutable heap buffers shared by copies.
+  std::array<NumberChars, kInlineArgs> inlineNumbers_;
+  std::vector<std::shared_ptr<NumberChars>> heapNumbers_;
+  std::uint8_t inlineNumberMask_ = 0;
+
+  std::size_t size_ = 0;
+  std::size_t valuesLength_ = 0;
+};
+
+template<typename CharT>
+constexpr std::size_t TransArgs<CharT>::kInlineArgs;
+
+namespace internal {
+
+/**
+ * Argument values passed to a MsgDescriptor overload of translate() or
+ * translatePlural(), viewed as strings, with numbers formatted in place.
+ */
+template<typename CharT, std::size_t NumArgs>
+class PositionalValues {
+public:
+  template<typename... Values>
+  explicit PositionalValues(const Values&... values) {
+    static_assert(
+        sizeof...(Values) == NumArgs, "must pass exactly one value per MsgDescriptor argument key");
+    std::size_t i = 0;
+    const int expand[] = {0, (set(i++, values), 0)...};
+    static_cast<void>(expand);
+  }
+
+  ~PositionalValues() = default;
+
+  PositionalValues(const PositionalValues&) = delete;
+  PositionalValues& operator=(const PositionalValues&) = delete;
+
+  PositionalValues(PositionalValues&&) = delete;
+  PositionalValues& operator=(PositionalValues&&) = delete;
+
+  const basic_string_view<CharT>* data() const { return views_.data(); }
+
+private:
+  template<
+      typename T, typename std::enable_if<!IsNumberArg<T, CharT>::value, int>::type = 0>
+  void set(std::size_t i, const T& value) {
+    views_[i] = basic_string_view<CharT>{value};
+  }
+
+  template<
+      typename T, typename std::enable_if<IsNumberArg<T, CharT>::value, int>::type = 0>
+  void set(std::size_t i, const T& number) {
+    CharT* chars = numbers_[i].data();
+    views_[i] = basic_string_view<CharT>{chars, NumberArg{number}.format(chars)};
+  }
+
+  std::array<basic_string_view<CharT>, NumArgs> views_;
+  std::array<std::array<CharT, kMaxNumberChars>, NumArgs> numbers_;
+};
+
+}  // namespace internal
+
+/** One message to translate with Translator::translateBatch(). */
+template<typename CharT>
+struct TransRequest {
+  basic_string_view<CharT> msgType;
+  const TransArgs<CharT>* args = nullptr;  // Optional, must outlive the batch call.
+  int pluralCount = internal::kNoCount;    // Non-negative for plural messages.
+};
+
+/** Why a translation failed (see TransResult). */
+enum class TransError : std::uint8_t {
+  kNone,            // Translated successfully.
+  kMissingMsgType,  // Message type was not configured.
+  kMissingArg,      // Message uses an argument that was not provided.
+  kInvalidArgs,     // Plural vs. non-plural mismatch, or no case for the plural count.
+};
+
+/**
+ * Expected-like result of a non-throwing translation (e.g.
+ * SimpleTranslator::tryTranslate()): either the translated string, or the
+ * error with the offending message type and (for TransError::kMissingArg)
+ * argument key. Failing never allocates.
+ *
+ * msgType() views the caller's message type string, and argKey() the
+ * translator's message template, so neither may outlive those.
+ */
+template<typename CharT>
+class TransResult {
+public:
+  using string_type = std::basic_string<CharT>;
+
+  /** Successful result. */
+  explicit TransResult(string_type value) : value_{std::move(value)} {}
+
+  /** Failed result. */
+  TransResult(
+      TransError error, basic_string_view<CharT> msgType,
+      basic_string_view<CharT> argKey = basic_string_view<CharT>{})
+      : error_{error}, msgType_{msgType}, argKey_{argKey} {
+    Expects(error != TransError::kNone);
+  }
+
+  ~TransResult() = default;
+
+  TransResult(const TransResult&) = default;
+  TransResult& operator=(const TransResult&) = default;
+
+  TransResult(TransResult&&) = default;
+  TransResult& operator=(TransResult&&) = default;
+
+  bool ok() const { return error_ == TransError::kNone; }
+  explicit operator bool() const { return ok(); }
+
+  TransError error() const { return error_; }
+
+  /** Message type that failed to translate (empty if ok()). */
+  basic_string_view<CharT> msgType() const { return msgType_; }
+
+  /** Key of the missing argument (empty unless error() is kMissingArg). */
+  basic_string_view<CharT> argKey() const { return argKey_; }
+
+  /** The translation, which requires ok(). */
+  const string_type& value() const& {
+    Expects(ok());
+    return value_;
+  }
+
+  /** Moves out the translation, which requires ok(). */
+  string_type value() && {
+    Expects(ok());
+    return std::move(value_);
+  }
+
+  /** The translation if ok(), else fallback. */
+  string_type valueOr(basic_string_view<CharT> fallback) const {
+    return ok() ? value_ : string_type{fallback.data(), fallback.size()};
+  }
+
+private:
+  string_type value_;
+  TransError error_ = TransError::kNone;
+  basic_string_view<CharT> msgType_;
+  basic_string_view<CharT> argKey_;
 };
 
 /**
@@ -115,6 +692,173 @@ public:
    */
   virtual string_type translatePlural(
       basic_string_view<CharT> msgType, int pluralCount, const TransArgs<CharT>& args) const = 0;
+
+  /**
+   * Resolves the given message type to a handle that can be used in place of
+   * it for faster translate() and translatePlural() calls. The message type
+   * string must outlive the returned handle.
+   *
+   * Resolving never fails: errors like an unconfigured message type are
+   * reported when translating with the handle, as for the string version.
+   *
+   * Default implementation returns an unresolved handle, for which the MsgId
+   * overloads below delegate to their message type string counterparts.
+   */
+  virtual MsgId<CharT> resolve(basic_string_view<CharT> msgType) const {
+    return MsgId<CharT>{msgType};
+  }
+
+  /** Same as translate(msgType), for a handle returned by resolve(). */
+  virtual string_type translate(const MsgId<CharT>& msgId) const {
+    return translate(msgId.msgType());
+  }
+
+  /** Same as translate(msgType, args), for a handle returned by resolve(). */
+  virtual string_type translate(const MsgId<CharT>& msgId, const TransArgs<CharT>& args) const {
+    return translate(msgId.msgType(), args);
+  }
+
+  /**
+   * Same as translatePlural(msgType, pluralCount, args), for a handle returned
+   * by resolve().
+   */
+  virtual string_type translatePlural(
+      const MsgId<CharT>& msgId, int pluralCount, const TransArgs<CharT>& args) const {
+    return translatePlural(msgId.msgType(), pluralCount, args);
+  }
+
+  /**
+   * Same as translatePlural(msgType, pluralCount, args), with the plural count
+   * taken from the argument with key countArgKey, which must be a non-negative
+   * integer (see TransArgs::pluralCount()), e.g.
+   * translatePlural(msgType, "numFiles", {{"numFiles", numFiles}}).
+   */
+  string_type translatePlural(
+      basic_string_view<CharT> msgType, basic_string_view<CharT> countArgKey,
+      const TransArgs<CharT>& args) const {
+    const int pluralCount = args.pluralCount(countArgKey);
+    Expects(pluralCount >= 0);
+    return translatePlural(msgType, pluralCount, args);
+  }
+
+  /** Same as translatePlural(msgType, countArgKey, args), for a handle returned by resolve(). */
+  string_type translatePlural(
+      const MsgId<CharT>& msgId, basic_string_view<CharT> countArgKey,
+      const TransArgs<CharT>& args) const {
+    const int pluralCount = args.pluralCount(countArgKey);
+    Expects(pluralCount >= 0);
+    return translatePlural(msgId, pluralCount, args);
+  }
+
+  /**
+   * Same as translate(msgType), but appends the translation to out (e.g. to
+   * reuse its capacity across calls). Appends nothing in cases where
+   * translate() would return an empty string on error.
+   *
+   * Default implementation appends the result of translate().
+   */
+  virtual void translateTo(string_type& out, basic_string_view<CharT> msgType) const {
+    out.append(translate(msgType));
+  }
+
+  /** Same as translate(msgType, args), but appends the translation to out. */
+  virtual void translateTo(
+      string_type& out, basic_string_view<CharT> msgType, const TransArgs<CharT>& args) const {
+    out.append(translate(msgType, args));
+  }
+
+  /** Same as translatePlural(msgType, pluralCount, args), but appends the translation to out. */
+  virtual void translatePluralTo(
+      string_type& out, basic_string_view<CharT> msgType, int pluralCount,
+      const TransArgs<CharT>& args) const {
+    out.append(translatePlural(msgType, pluralCount, args));
+  }
+
+  /**
+   * Translates all requests (each like translate() or translatePlural(),
+   * depending on its pluralCount) into one contiguous buffer: replaces out
+   * with all translations concatenated, and offsets with requests.size() + 1
+   * entries, such that translation i is the range [offsets[i], offsets[i + 1])
+   * of out. Reusing out and offsets across batches amortizes allocation.
+   *
+   * Error handling is the same as for the individual calls: with exceptions
+   * disabled, failed translations are empty.
+   *
+   * Default implementation appends each translation with translateTo() or
+   * translatePluralTo().
+   */
+  virtual void translateBatch(
+      gsl::span<const TransRequest<CharT>> requests, string_type& out,
+      std::vector<std::size_t>& offsets) const {
+    const TransArgs<CharT> noArgs;
+    out.clear();
+    offsets.clear();
+    offsets.reserve(requests.size() + 1);
+
+    for (const auto& request : requests) {
+      offsets.push_back(out.size());
+      const TransArgs<CharT>& args = (request.args != nullptr) ? *request.args : noArgs;
+      if (request.pluralCount == internal::kNoCount) {
+        translateTo(out, request.msgType, args);
+      } else {
+        translatePluralTo(out, request.msgType, request.pluralCount, args);
+      }
+    }
+    offsets.push_back(out.size());
+  }
+
+  /**
+   * Translates the given non-plural message, with argument values passed in
+   * the same order as the descriptor's argument keys. Values can be strings or
+   * numbers, as for TransArgs::add(). Error handling is the same as
+   * translate() with TransArgs.
+   */
+  template<std::size_t NumArgs, typename... Values>
+  string_type translate(const MsgDescriptor<CharT, NumArgs>& msg, const Values&... values) const {
+    const internal::PositionalValues<CharT, NumArgs> valueViews{values...};
+    return translatePositional(
+        msg.msgType(), internal::kNoCount, msg.argKeys().data(), msg.argKeysHash(),
+        valueViews.data(), NumArgs);
+  }
+
+  /**
+   * Translates the given plural message, with argument values passed in the
+   * same order as the descriptor's argument keys. Given pluralCount must be
+   * non-negative. Error handling is the same as translatePlural().
+   */
+  template<std::size_t NumArgs, typename... Values>
+  string_type translatePlural(
+      const MsgDescriptor<CharT, NumArgs>& msg, int pluralCount, const Values&... values) const {
+    Expects(pluralCount >= 0);
+    const internal::PositionalValues<CharT, NumArgs> valueViews{values...};
+    return translatePositional(
+        msg.msgType(), pluralCount, msg.argKeys().data(), msg.argKeysHash(), valueViews.data(),
+        NumArgs);
+  }
+
+protected:
+  /**
+   * Implements the MsgDescriptor overloads of translate() (if pluralCount is
+   * internal::kNoCount) and translatePlural(). The argKeys and values arrays
+   * both have numArgs entries, and argKeysHash is the descriptor's
+   * argKeysHash().
+   *
+   * Default implementation collects the arguments into TransArgs and delegates
+   * to translate() or translatePlural().
+   */
+  virtual string_type translatePositional(
+      basic_string_view<CharT> msgType, int pluralCount, const basic_string_view<CharT>* argKeys,
+      std::uint64_t argKeysHash, const basic_string_view<CharT>* values,
+      std::size_t numArgs) const {
+    static_cast<void>(argKeysHash);  // Suppress unreferenced parameter warning.
+    TransArgs<CharT> args;
+    for (std::size_t i = 0; i < numArgs; ++i) {
+      args.add(argKeys[i], values[i]);
+    }
+
+    return (pluralCount == internal::kNoCount) ? translate(msgType, args)
+                                               : translatePlural(msgType, pluralCount, args);
+  }
 };
 
 }  // namespace simple_tr8n
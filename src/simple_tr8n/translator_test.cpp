@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: 2022 Eric Barndollar
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "simple_tr8n/simple_translator.hpp"
+#include "simple_tr8n/translator.hpp"
+
+namespace {
+
+// Counts all heap allocations made by this test binary.
+std::atomic<std::size_t> numAllocations{0};
+
+void* countedAlloc(std::size_t size) {
+  ++numAllocations;
+  void* ptr = std::malloc((size > 0) ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+/** Fixed buffer that ArenaAllocator bumps through, never freeing. */
+struct Arena {
+  alignas(std::max_align_t) char buffer[1024];
+  std::size_t used = 0;
+  std::size_t numAllocations = 0;
+};
+
+/** Minimal allocator drawing from an Arena. */
+template<typename T>
+class ArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena& arena) : arena_{&arena} {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_{other.arena()} {}
+
+  T* allocate(std::size_t n) {
+    const std::size_t size = (n * sizeof(T) + alignof(std::max_align_t) - 1) &
+                             ~(alignof(std::max_align_t) - 1);
+    if (arena_->used + size > sizeof(arena_->buffer)) {
+      throw std::bad_alloc{};
+    }
+    ++arena_->numAllocations;
+    T* const ptr = reinterpret_cast<T*>(arena_->buffer + arena_->used);
+    arena_->used += size;
+    return ptr;
+  }
+
+  void deallocate(T*, std::size_t) {}
+
+  Arena* arena() const { return arena_; }
+
+  template<typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+
+  template<typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  Arena* arena_;
+};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size) {
+  return countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace test_msgs {
+
+constexpr char kFourArgs[] = "test.four_args";
+constexpr char kPlural[] = "test.plural";
+
+}  // namespace test_msgs
+
+using ::testing::Eq;
+using ::testing::IsNull;
+using ::testing::Pointee;
+
+TEST(TransArgsTest, ShouldFindArgs) {
+  simple_tr8n::TransArgs<char> args{{"a", "1"}, {"b", "22"}};
+  args.add("c", "333");
+
+  EXPECT_TRUE(args.has("b"));
+  EXPECT_FALSE(args.has("d"));
+  EXPECT_THAT(args.get("c"), Eq("333"));
+  EXPECT_THAT(args.get("d"), Eq(""));
+  EXPECT_THAT(args.find("a"), Pointee(Eq("1")));
+  EXPECT_THAT(args.find("d"), IsNull());
+  EXPECT_THAT(args.size(), Eq(3u));
+  EXPECT_THAT(args.valuesLength(), Eq(6u));
+}
+
+TEST(TransArgsTest, ShouldFindArgsBeyondInlineCapacity) {
+  const std::string keys[] = {"k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7"};
+  const std::string values[] = {"v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7"};
+
+  simple_tr8n::TransArgs<char> args;
+  for (std::size_t i = 0; i < 8; ++i) {
+    args.add(keys[i], values[i]);
+  }
+
+  for (std::size_t i = 0; i < 8; ++i) {
+    EXPECT_THAT(args.get(keys[i]), Eq(values[i]));
+    EXPECT_THAT(args.at(i).first, Eq(keys[i]));
+    EXPECT_THAT(args.at(i).second, Eq(values[i]));
+  }
+  EXPECT_THAT(args.size(), Eq(8u));
+  EXPECT_THAT(args.valuesLength(), Eq(16u));
+}
+
+TEST(TransArgsTest, ShouldFormatNumberArgs) {
+  simple_tr8n::TransArgs<char> args{{"int", -42}, {"name", "Bo"}, {"zero", 0u}};
+  args.add("half", 0.5).add("big", 1e20).add("min", std::numeric_limits<std::int64_t>::min());
+  args.add("max", std::numeric_limits<std::uint64_t>::max()).add("float", 1.25f);
+
+  EXPECT_THAT(args.get("int"), Eq("-42"));
+  EXPECT_THAT(args.get("name"), Eq("Bo"));
+  EXPECT_THAT(args.get("zero"), Eq("0"));
+  EXPECT_THAT(args.get("half"), Eq("0.5"));
+  EXPECT_THAT(args.get("big"), Eq("1e+20"));
+  EXPECT_THAT(args.get("min"), Eq("-9223372036854775808"));
+  EXPECT_THAT(args.at(6).second, Eq("18446744073709551615"));
+  EXPECT_THAT(args.get("float"), Eq("1.25"));
+  EXPECT_THAT(args.valuesLength(), Eq(58u));
+
+  simple_tr8n::TransArgs<wchar_t> wideArgs{{L"n", 1234}};
+  wideArgs.add(L"x", -0.25);
+  EXPECT_THAT(wideArgs.get(L"n"), Eq(L"1234"));
+  EXPECT_THAT(wideArgs.get(L"x"), Eq(L"-0.25"));
+}
+
+TEST(TransArgsTest, ShouldCopyNumberArgs) {
+  simple_tr8n::TransArgs<char> copy;
+  {
+    simple_tr8n::TransArgs<char> args{{"a", 1}, {"b", "2"}, {"c", 3}, {"d", 4}};
+    args.add("e", 5).add("f", 6.5);
+    copy = args;
+
+    simple_tr8n::TransArgs<char> moved{std::move(args)};
+    EXPECT_THAT(moved.get("a"), Eq("1"));
+    EXPECT_THAT(moved.get("f"), Eq("6.5"));
+  }
+
+  const simple_tr8n::TransArgs<char> copy2{copy};
+  for (const auto& args : {std::cref(copy), std::cref(copy2)}) {
+    EXPECT_THAT(args.get().get("a"), Eq("1"));
+    EXPECT_THAT(args.get().get("b"), Eq("2"));
+    EXPECT_THAT(args.get().get("d"), Eq("4"));
+    EXPECT_THAT(args.get().get("e"), Eq("5"));
+    EXPECT_THAT(args.get().get("f"), Eq("6.5"));
+  }
+}
+
+TEST(TransArgsTest, ShouldGetPluralCount) {
+  const simple_tr8n::TransArgs<char> args{
+      {"int", 7},    {"str", "12"},      {"neg", -1},      {"half", 0.5},
+      {"empty", ""}, {"big", 1ll << 40}, {"maxInt", "2147483647"}};
+
+  EXPECT_THAT(args.pluralCount("int"), Eq(7));
+  EXPECT_THAT(args.pluralCount("str"), Eq(12));
+  EXPECT_THAT(args.pluralCount("maxInt"), Eq(2147483647));
+  for (const char* key : {"neg", "half", "empty", "big", "missing"}) {
+    EXPECT_THAT(args.pluralCount(key), Eq(simple_tr8n::internal::kNoCount)) << key;
+  }
+}
+
+TEST(TransArgsTest, ShouldNotAllocateInlineArgs) {
+  const std::size_t before = numAllocations;
+  {
+    simple_tr8n::TransArgs<char> args{{"a", "1"}, {"b", "2"}, {"c", "3"}};
+    args.add("d", "4");
+    EXPECT_THAT(args.get("d"), Eq("4"));
+  }
+  EXPECT_THAT(numAllocations - before, Eq(0u));
+
+  {
+    simple_tr8n::TransArgs<char> args{{"a", "1"}, {"b", "2"}, {"c", "3"}, {"d", "4"}};
+    args.add("e", "5");  // Spills to the heap.
+    EXPECT_THAT(args.get("e"), Eq("5"));
+  }
+  EXPECT_THAT(numAllocations - before, Eq(1u));
+}
+
+TEST(TransArgsTest, ShouldTranslateFourArgsWithoutAllocating) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kFourArgs, "%{a}+%{b}=%{c}%{d}");
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+
+  std::string out;
+  out.reserve(64);
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  // Allocates this thread's metrics counters.
+  translator.translateTo(
+      out, test_msgs::kFourArgs, {{"a", "0"}, {"b", "0"}, {"c", "0"}, {"d", "?"}});
+  out.clear();
+#endif
+
+  const std::size_t before = numAllocations;
+  translator.translateTo(
+      out, test_msgs::kFourArgs, {{"a", "1"}, {"b", "2"}, {"c", "3"}, {"d", "!"}});
+  EXPECT_THAT(numAllocations - before, Eq(0u));
+  EXPECT_THAT(out, Eq("1+2=3!"));
+}
+
+TEST(TransArgsTest, ShouldTranslateNumberArgsWithoutAllocating) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kFourArgs, "%{a}+%{b}=%{c}%{d}");
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+
+  std::string out;
+  out.reserve(64);
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  // Allocates this thread's metrics counters.
+  translator.translateTo(out, test_msgs::kFourArgs, {{"a", 0}, {"b", 0}, {"c", 0}, {"d", "?"}});
+  out.clear();
+#endif
+
+  const std::size_t before = numAllocations;
+  translator.translateTo(
+      out, test_msgs::kFourArgs, {{"a", 0.25}, {"b", 1000000}, {"c", 1000000.25}, {"d", "!"}});
+  EXPECT_THAT(numAllocations - before, Eq(0u));
+  EXPECT_THAT(out, Eq("0.25+1000000=1000000.25!"));
+}
+
+TEST(TransArgsTest, ShouldFailTryTranslateWithoutAllocating) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kFourArgs, "%{a}+%{b}=%{c}%{d}");
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  // Allocates this thread's metrics counters (but not entries for missing types).
+  static_cast<void>(translator.tryTranslate("test.other_missing"));
+#endif
+
+  const std::size_t before = numAllocations;
+  const auto missingType = translator.tryTranslate("test.missing");
+  const auto missingArg = translator.tryTranslate(test_msgs::kFourArgs, {{"a", "1"}, {"b", "2"}});
+  const auto invalidArgs = translator.tryTranslatePlural(test_msgs::kFourArgs, 1, {});
+  EXPECT_THAT(numAllocations - before, Eq(0u));
+
+  EXPECT_THAT(missingType.error(), Eq(simple_tr8n::TransError::kMissingMsgType));
+  EXPECT_THAT(missingArg.argKey(), Eq("c"));
+  EXPECT_THAT(invalidArgs.error(), Eq(simple_tr8n::TransError::kInvalidArgs));
+}
+
+TEST(TransArgsTest, ShouldTranslateWithAllocator) {
+  auto configs = std::make_unique<simple_tr8n::MsgConfigs<char>>();
+  configs->add(test_msgs::kFourArgs, "%{a}+%{b}=%{c}%{d} (long enough to allocate)")
+      .add(test_msgs::kPlural, {{0, "none"}, {1, "%{a} or more (long enough to allocate)"}});
+  const simple_tr8n::SimpleTranslator<char> translator{std::move(configs)};
+  const simple_tr8n::TransArgs<char> args{{"a", 1}, {"b", 2}, {"c", 3}, {"d", "!"}};
+  const auto pluralId = translator.resolve(test_msgs::kPlural);
+#ifdef SIMPLE_TR8N_ENABLE_METRICS
+  // Allocates this thread's metrics counters.
+  translator.translate(test_msgs::kFourArgs, args);
+#endif
+
+  Arena arena;
+  const ArenaAllocator<char> alloc{arena};
+  const std::size_t before = numAllocations;
+  const auto msg = translator.translate(std::allocator_arg, alloc, test_msgs::kFourArgs, args);
+  const auto pluralMsg = translator.translatePlural(std::allocator_arg, alloc, pluralId, 3, args);
+  EXPECT_THAT(numAllocations - before, Eq(0u));
+  EXPECT_THAT(arena.numAllocations, Eq(2u));
+
+  EXPECT_THAT(msg, Eq("1+2=3! (long enough to allocate)"));
+  EXPECT_THAT(pluralMsg, Eq("1 or more (long enough to allocate)"));
+  EXPECT_TRUE(msg.get_allocator() == alloc);
+}